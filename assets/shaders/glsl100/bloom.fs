@@ -0,0 +1,37 @@
+#version 100
+
+precision mediump float;
+
+// Single pass bloom: the bright parts of a small blur around each texel are
+// added back on top. The blur radius is in game pixels so it looks the same
+// at every render resolution. texture0 is the previous pass.
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+uniform vec2 sourceSize;    // game resolution in pixels
+
+const float Threshold = 0.7;
+const float Intensity = 0.6;
+
+void main()
+{
+    vec4 texel = texture2D(texture0, fragTexCoord);
+    vec2 pixel = 1.0/sourceSize;
+
+    vec3 glow = vec3(0.0);
+    for (int x = -2; x <= 2; x++)
+    {
+        for (int y = -2; y <= 2; y++)
+        {
+            vec3 neighbour = texture2D(texture0, fragTexCoord + vec2(float(x), float(y))*pixel).rgb;
+            glow += max(neighbour - Threshold, 0.0);
+        }
+    }
+    glow /= 25.0;
+
+    gl_FragColor = vec4(texel.rgb + glow*Intensity/(1.0 - Threshold), texel.a)*colDiffuse*fragColor;
+}
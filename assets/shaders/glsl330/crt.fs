@@ -0,0 +1,41 @@
+#version 330
+
+// CRT post-process pass: slight screen curvature, one scanline per game pixel
+// row and a vignette. texture0 is the previous pass at render resolution.
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+uniform vec2 sourceSize;    // game resolution in pixels
+
+out vec4 finalColor;
+
+const float Curvature = 0.03;
+const float ScanlineStrength = 0.25;
+const float VignetteStrength = 0.35;
+
+void main()
+{
+    vec2 centered = fragTexCoord*2.0 - 1.0;
+    centered *= 1.0 + Curvature*dot(centered.yx, centered.yx);
+    vec2 uv = centered*0.5 + 0.5;
+
+    if (uv.x < 0.0 || uv.x > 1.0 || uv.y < 0.0 || uv.y > 1.0)
+    {
+        finalColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    vec3 color = texture(texture0, uv).rgb;
+
+    float scanline = 0.5 + 0.5*cos(uv.y*sourceSize.y*6.2831853);
+    color *= 1.0 - ScanlineStrength*scanline;
+
+    float vignette = 1.0 - VignetteStrength*dot(centered, centered)*0.5;
+    color *= vignette;
+
+    finalColor = vec4(color, 1.0)*colDiffuse*fragColor;
+}
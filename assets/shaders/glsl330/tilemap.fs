@@ -0,0 +1,44 @@
+#version 330
+
+// Draws a whole tile layer from a single quad. texture0 is the layer's index
+// texture, with one texel per cell:
+//   r = tileset column, g = tileset row, b = flip bits (1 = x, 2 = y), a = 0 if the cell is empty
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+uniform sampler2D tileset;
+uniform vec2 tilesetSize;   // in pixels
+uniform vec2 gridSize;      // layer size in cells
+uniform float tileSize;     // in pixels
+uniform float tileSpacing;  // in pixels
+uniform float tilePadding;  // in pixels
+
+out vec4 finalColor;
+
+void main()
+{
+    vec2 cellPos = fragTexCoord*gridSize;
+    vec2 cell = floor(cellPos);
+    vec4 index = texture(texture0, (cell + 0.5)/gridSize);
+
+    if (index.a < 0.5) discard;
+
+    vec2 tileCoords = floor(index.rg*255.0 + 0.5);
+    float flips = floor(index.b*255.0 + 0.5);
+
+    vec2 inTile = cellPos - cell;
+    if (mod(flips, 2.0) >= 1.0) inTile.x = 1.0 - inTile.x;
+    if (flips >= 2.0) inTile.y = 1.0 - inTile.y;
+
+    vec2 tileOrigin = vec2(tilePadding) + tileCoords*(tileSize + tileSpacing);
+    vec2 uv = (tileOrigin + inTile*tileSize)/tilesetSize;
+
+    vec4 texel = texture(tileset, uv);
+    if (texel.a == 0.0) discard;
+
+    finalColor = texel*colDiffuse*fragColor;
+}
@@ -0,0 +1,28 @@
+# Included by CTest through the file written in the tests section of
+# CMakeLists.txt, with TESTS_EXECUTABLE and TESTS_WORKING_DIRECTORY set.
+#
+# Adds a test for every name `tests --list` prints, so every test registered
+# in tests/*.cpp runs without listing it here too.
+
+if(NOT EXISTS "${TESTS_EXECUTABLE}")
+    # fails when run, so a missing build doesn't look like a passing one
+    add_test(tests_not_built "${TESTS_EXECUTABLE}")
+    return()
+endif()
+
+execute_process(
+    COMMAND "${TESTS_EXECUTABLE}" --list
+    OUTPUT_VARIABLE testNames
+    RESULT_VARIABLE listResult)
+
+if(NOT listResult EQUAL 0)
+    message(FATAL_ERROR "${TESTS_EXECUTABLE} --list failed: ${listResult}")
+endif()
+
+string(STRIP "${testNames}" testNames)
+string(REPLACE "\n" ";" testNames "${testNames}")
+
+foreach(testName IN LISTS testNames)
+    add_test(${testName} "${TESTS_EXECUTABLE}" ${testName})
+    set_tests_properties(${testName} PROPERTIES WORKING_DIRECTORY "${TESTS_WORKING_DIRECTORY}")
+endforeach()
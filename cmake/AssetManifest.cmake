@@ -0,0 +1,64 @@
+# Generates a manifest listing the assets each LDtk level references (its
+# background image and the tilesets of its layers), one "<level>\t<path>" pair
+# per line with paths relative to the assets folder. The web build uses it to
+# fetch each level's assets on demand instead of preloading everything.
+function(generate_asset_manifest ldtkFile outputFile)
+    file(READ "${ldtkFile}" ldtkJson)
+    set(manifest "")
+
+    string(JSON levelCount LENGTH "${ldtkJson}" levels)
+    math(EXPR lastLevel "${levelCount} - 1")
+
+    foreach(levelIndex RANGE ${lastLevel})
+        string(JSON levelName GET "${ldtkJson}" levels ${levelIndex} identifier)
+        set(levelAssets "")
+
+        string(JSON bgType TYPE "${ldtkJson}" levels ${levelIndex} bgRelPath)
+        if(bgType STREQUAL "STRING")
+            string(JSON bgPath GET "${ldtkJson}" levels ${levelIndex} bgRelPath)
+            list(APPEND levelAssets "${bgPath}")
+        endif()
+
+        string(JSON layersType TYPE "${ldtkJson}" levels ${levelIndex} layerInstances)
+        if(layersType STREQUAL "ARRAY")
+            string(JSON layerCount LENGTH "${ldtkJson}" levels ${levelIndex} layerInstances)
+            if(layerCount GREATER 0)
+                math(EXPR lastLayer "${layerCount} - 1")
+                foreach(layerIndex RANGE ${lastLayer})
+                    string(JSON tilesetType TYPE "${ldtkJson}" levels ${levelIndex} layerInstances ${layerIndex} __tilesetRelPath)
+                    if(tilesetType STREQUAL "STRING")
+                        string(JSON tilesetPath GET "${ldtkJson}" levels ${levelIndex} layerInstances ${layerIndex} __tilesetRelPath)
+                        list(APPEND levelAssets "${tilesetPath}")
+                    endif()
+                endforeach()
+            endif()
+        endif()
+
+        list(REMOVE_DUPLICATES levelAssets)
+        foreach(asset IN LISTS levelAssets)
+            string(APPEND manifest "${levelName}\t${asset}\n")
+        endforeach()
+    endforeach()
+
+    file(WRITE "${outputFile}" "${manifest}")
+
+    # re-run the configure step whenever the LDtk project changes
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${ldtkFile}")
+endfunction()
+
+# Reads a manifest written by generate_asset_manifest and returns the unique
+# list of assets it references, across all levels
+function(get_manifest_assets manifestFile outVar)
+    file(STRINGS "${manifestFile}" manifestLines)
+    set(assets "")
+
+    foreach(line IN LISTS manifestLines)
+        string(FIND "${line}" "\t" separator)
+        math(EXPR pathStart "${separator} + 1")
+        string(SUBSTRING "${line}" ${pathStart} -1 asset)
+        list(APPEND assets "${asset}")
+    endforeach()
+
+    list(REMOVE_DUPLICATES assets)
+    set(${outVar} "${assets}" PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,47 @@
+# Reads the `ASSET(ID, "path")` entries of sources/utils/AssetRegistry.hpp and
+# returns the paths they register, relative to the assets folder. Shaders
+# (`ASSET_SHADER_DIR "name"`) are returned once per GLSL version.
+function(get_registered_assets registryHeader outVar)
+    # entries stop before the macro's line continuations, a trailing backslash
+    # would escape the separator of the resulting list
+    file(READ "${registryHeader}" registry)
+    string(REGEX MATCHALL "\n[ \t]*ASSET\\([^\n\\]*" entries "${registry}")
+    set(assets "")
+
+    foreach(entry IN LISTS entries)
+        if(NOT entry MATCHES "ASSET\\(([A-Z0-9_]+), (ASSET_SHADER_DIR )?\"([^\"]+)\"\\)")
+            message(FATAL_ERROR "Can't parse asset registry entry: ${entry}")
+        endif()
+
+        if(CMAKE_MATCH_2)
+            list(APPEND assets "shaders/glsl100/${CMAKE_MATCH_3}" "shaders/glsl330/${CMAKE_MATCH_3}")
+        else()
+            list(APPEND assets "${CMAKE_MATCH_3}")
+        endif()
+    endforeach()
+
+    set(${outVar} "${assets}" PARENT_SCOPE)
+endfunction()
+
+# Fails if any registered asset is missing from `assetsDir`
+function(check_registered_assets registryHeader assetsDir)
+    get_registered_assets("${registryHeader}" assets)
+    set(missing "")
+
+    foreach(asset IN LISTS assets)
+        if(NOT EXISTS "${assetsDir}/${asset}")
+            list(APPEND missing "${asset}")
+        endif()
+    endforeach()
+
+    if(missing)
+        list(JOIN missing "\n  " missingList)
+        message(FATAL_ERROR "Assets registered in ${registryHeader} are missing from ${assetsDir}:\n  ${missingList}")
+    endif()
+endfunction()
+
+# Run as a script by the check-assets target:
+# cmake -DREGISTRY_HEADER=<header> -DASSETS_DIR=<dir> -P CheckAssets.cmake
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    check_registered_assets("${REGISTRY_HEADER}" "${ASSETS_DIR}")
+endif()
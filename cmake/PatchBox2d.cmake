@@ -0,0 +1,39 @@
+# Run as box2d's FetchContent PATCH_COMMAND with -DBOX2D_SOURCE_DIR=<dir>.
+#
+# box2d 2.4.1 counts GJK and time of impact calls in plain globals
+# (b2_gjkCalls, b2_toiIters, ...) that every b2World::Step writes to. The
+# batch runner steps several worlds on worker threads at once, so those
+# writes race. Making the counters thread_local keeps each thread's counts to
+# itself, nothing in the game reads them. b2_user_settings.h can't do this,
+# the counters are declared and defined outside of it.
+#
+# Patching twice is harmless, already patched declarations don't match.
+
+if(NOT BOX2D_SOURCE_DIR)
+    message(FATAL_ERROR "BOX2D_SOURCE_DIR is not set")
+endif()
+
+file(GLOB_RECURSE counterFiles
+    "${BOX2D_SOURCE_DIR}/include/box2d/b2_distance.h"
+    "${BOX2D_SOURCE_DIR}/include/box2d/b2_time_of_impact.h"
+    "${BOX2D_SOURCE_DIR}/src/*/b2_distance.cpp"
+    "${BOX2D_SOURCE_DIR}/src/*/b2_time_of_impact.cpp")
+
+set(patchedCount 0)
+foreach(counterFile IN LISTS counterFiles)
+    file(READ "${counterFile}" contents)
+    string(REGEX REPLACE "B2_API (int32|float) b2_(gjk|toi)" "B2_API thread_local \\1 b2_\\2" patched "${contents}")
+
+    if(NOT patched STREQUAL contents)
+        file(WRITE "${counterFile}" "${patched}")
+    endif()
+
+    if(patched MATCHES "thread_local")
+        math(EXPR patchedCount "${patchedCount} + 1")
+    endif()
+endforeach()
+
+# two headers and their two sources, anything else means box2d moved them
+if(NOT patchedCount EQUAL 4)
+    message(FATAL_ERROR "Expected to make box2d's counters thread_local in 4 files, did it in ${patchedCount}")
+endif()
@@ -1,28 +1,173 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
-using namespace std;
+// Constants are constexpr, so including this header costs no static
+// initialization and no per translation unit copies of strings
 
-const int ScreenScale = 2;
+constexpr int ScreenScale = 2;
 namespace GameConstants
 {
-    const int WorldWidth = 400;
-    const int WorldHeight = 400;
+    constexpr int WorldWidth = 400;
+    constexpr int WorldHeight = 400;
 
-    const int CellSize = 16;
-    const float PhysicsWorldScale = 16.0f / ScreenScale; // everything is this times bigger than what physics world says
+    constexpr int CellSize = 16;
+    constexpr float PhysicsWorldScale = 16.0f / ScreenScale; // everything is this times bigger than what physics world says
+
+    // Gameplay always advances in fixed steps of this many seconds, so a run
+    // only depends on its inputs and not on the frame rate
+    constexpr float TickDuration = 1.0f / 60.0f;
+
+    // Most simulation ticks a single frame may catch up on after a hitch
+    constexpr int MaxTicksPerFrame = 5;
 }
 
 namespace AppConstants
 {
-    const string WindowTitle = "Window Title";
+    // Literals are null terminated, so `.data()` can be passed to raylib
+    constexpr std::string_view WindowTitle = "Window Title";
+
+    constexpr int ScreenWidth = GameConstants::WorldWidth * ScreenScale;
+    constexpr int ScreenHeight = GameConstants::WorldHeight * ScreenScale;
 
-    const int ScreenWidth = GameConstants::WorldWidth * ScreenScale;
-    const int ScreenHeight = GameConstants::WorldHeight * ScreenScale;
+    // Desktop builds cap the frame rate at this, web builds run at whatever
+    // rate the browser calls them
+    constexpr int TargetFps = 60;
 
-    inline string GetAssetPath(string assetName)
+    // For names only known at runtime (like the files an LDtk level
+    // references). Fixed assets have compile-time paths in AssetRegistry.
+    inline std::string GetAssetPath(std::string_view assetName)
     {
-        return ASSETS_PATH "" + assetName;
+        std::string path = ASSETS_PATH;
+        path += assetName;
+        return path;
     }
 }
+
+namespace RenderingConstants
+{
+    // Draw LDtk tile layers with the tile index shader instead of baking every tile
+    // into the level texture. Falls back to baking if the shader can't be loaded.
+    constexpr bool GpuTileLayers = true;
+}
+
+namespace StreamingConstants
+{
+    // Stream every level of the LDtk world around the player into one physics
+    // world, instead of loading a single level at a time
+    constexpr bool Enabled = false;
+
+    // Distances (in world pixels) from the player to a level's bounds at which
+    // that level is loaded/unloaded. Unload is further away to avoid thrashing.
+    constexpr float LoadDistance = 200.0f;
+    constexpr float UnloadDistance = 400.0f;
+}
+
+namespace ProfilingConstants
+{
+    // Allocations a steady-state gameplay frame may do when built with TRACK_ALLOCATIONS
+    constexpr int FrameAllocationBudget = 0;
+
+    // Frames after a level is loaded during which allocations are not checked
+    constexpr int AllocationWarmupFrames = 60;
+}
+
+namespace ActorConstants
+{
+    // CPU time (in ms) actor updates may take per simulation tick in the
+    // game. Actors that are due but don't fit are the first ones updated on
+    // the next tick.
+    constexpr float TickBudgetMs = 0.5f;
+
+    // Budget that never runs out, large enough to never be spent but not so
+    // large that the deadline overflows. Simulations that are hashed use it,
+    // what fits a real budget depends on the machine.
+    constexpr float UnlimitedBudgetMs = 1e6f;
+
+    // Actors closer than this (in world pixels) to the camera update every
+    // tick, further than FarDistance they update every FarUpdateInterval
+    // seconds and in between every MidUpdateInterval seconds
+    constexpr float NearDistance = 300.0f;
+    constexpr float FarDistance = 800.0f;
+    constexpr float MidUpdateInterval = 1.0f / 15.0f;
+    constexpr float FarUpdateInterval = 1.0f / 4.0f;
+
+    // Longest time a single update catches up on, actors starved for longer lose the rest
+    constexpr float MaxCatchUp = 0.25f;
+}
+
+namespace NetworkConstants
+{
+    // Ticks between a local input and the tick it is applied on. Hides that
+    // much latency without any rollback.
+    constexpr int InputDelay = 2;
+
+    // Furthest back a late remote input may roll the simulation. When the
+    // remote player falls further behind the session waits for them instead.
+    constexpr int MaxRollback = 8;
+}
+
+namespace AudioConstants
+{
+    constexpr int SampleRate = 48000;
+
+    // Frames the mixer produces per callback. The device double buffers, so
+    // output latency is about two of these (~10 ms).
+    constexpr int BufferFrames = 256;
+
+    // Sound effects that can play at once, a new one steals the oldest
+    // voice of the lowest priority when they are all busy
+    constexpr int VoiceCount = 16;
+
+    // Play requests that can be waiting for the mixer, must be a power of two
+    constexpr int RequestQueueSize = 64;
+
+    // Frames music is decoded in. Music is refilled once per game frame, so
+    // this has to cover a slow frame.
+    constexpr int MusicChunkFrames = 4096;
+}
+
+namespace NavigationConstants
+{
+    // Free cells an agent needs to stand somewhere, counting up from the
+    // cell its feet are in
+    constexpr int AgentHeightCells = 2;
+
+    // Furthest a jump link may go up and sideways, in cells
+    constexpr int JumpHeightCells = 3;
+    constexpr int JumpDistanceCells = 4;
+
+    // Nodes a flow field build settles between checks for a newer target.
+    // Without threads (web) this is the work done per frame.
+    constexpr int NodesPerSlice = 4096;
+}
+
+namespace LightingConstants
+{
+    // Rays cast at even steps around every light on top of the ones aimed at
+    // occluder corners, they round off the edge of the lit area
+    constexpr int BoundaryRays = 48;
+
+    // Reach (in world pixels) of the light the player carries and of `Light`
+    // entities that don't set their own radius
+    constexpr float PlayerLightRadius = 140.0f;
+    constexpr float DefaultLightRadius = 96.0f;
+}
+
+namespace QualityConstants
+{
+    // Frames the governor looks at before each decision, it goes by their
+    // median so one-off hitches (loading a level) don't count
+    constexpr int WindowFrames = 60;
+
+    // How far over one refresh the median frame may be before it counts as
+    // a missed frame, frame pacing is never exact
+    constexpr float FrameBudgetTolerance = 0.1f;
+
+    // Windows within the target to wait before trying the next level up.
+    // Doubles every time an upgrade is taken back by the next window, up to
+    // MaxUpgradeDelayWindows.
+    constexpr int UpgradeDelayWindows = 5;
+    constexpr int MaxUpgradeDelayWindows = 60;
+}
@@ -0,0 +1,327 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <raylib.h>
+
+#include <Constants.hpp>
+
+#include "AudioEngine.hpp"
+
+namespace
+{
+	// 16-bit stereo PCM, the header is written again with the real sizes on close
+	class WavFileWriter
+	{
+	private:
+		FILE *file = nullptr;
+		uint32_t frames = 0;
+
+		template <typename T>
+		void write(T value)
+		{
+			std::fwrite(&value, sizeof(T), 1, file);
+		}
+
+		void write_header()
+		{
+			constexpr uint16_t Channels = 2;
+			constexpr uint16_t BitsPerSample = 16;
+			constexpr uint16_t BlockAlign = Channels * BitsPerSample / 8;
+			uint32_t dataSize = frames * BlockAlign;
+
+			std::fseek(file, 0, SEEK_SET);
+			std::fwrite("RIFF", 1, 4, file);
+			write<uint32_t>(36 + dataSize);
+			std::fwrite("WAVEfmt ", 1, 8, file);
+			write<uint32_t>(16);
+			write<uint16_t>(1); // PCM
+			write<uint16_t>(Channels);
+			write<uint32_t>(AudioConstants::SampleRate);
+			write<uint32_t>(AudioConstants::SampleRate * BlockAlign);
+			write<uint16_t>(BlockAlign);
+			write<uint16_t>(BitsPerSample);
+			std::fwrite("data", 1, 4, file);
+			write<uint32_t>(dataSize);
+		}
+
+	public:
+		bool open(const std::string &path)
+		{
+			file = std::fopen(path.c_str(), "wb");
+			if (file == nullptr)
+			{
+				return false;
+			}
+
+			write_header();
+			return true;
+		}
+
+		void write_frames(const float *samples, int count)
+		{
+			for (int i = 0; i < count * 2; i++)
+			{
+				write<int16_t>(int16_t(samples[i] * 32767.0f));
+			}
+			frames += count;
+		}
+
+		void close()
+		{
+			if (file == nullptr)
+			{
+				return;
+			}
+
+			write_header();
+			std::fclose(file);
+			file = nullptr;
+		}
+	};
+
+	struct EngineState
+	{
+		AudioOutput output = AudioOutput::NONE;
+		AudioMixer mixer;
+		std::array<SoundData, SoundEffectCount> sounds;
+
+		AudioStream stream{};
+		WavFileWriter wavFile;
+
+		// mix buffer and frames owed to the mixer when the game loop drives it
+		std::vector<float> buffer;
+		float pendingFrames = 0;
+
+		Music music{};
+		bool musicLoaded = false;
+	};
+
+	std::unique_ptr<EngineState> engine;
+
+	// raylib's stream callback takes no user data, so it finds the mixer through this
+	AudioMixer *callbackMixer = nullptr;
+
+	void mix_callback(void *bufferData, unsigned int frames)
+	{
+		callbackMixer->mix(static_cast<float *>(bufferData), int(frames));
+	}
+
+	bool open_device()
+	{
+		InitAudioDevice();
+		if (!IsAudioDeviceReady())
+		{
+			return false;
+		}
+
+		// small buffers keep latency low, the callback just has to keep up
+		SetAudioStreamBufferSizeDefault(AudioConstants::BufferFrames);
+		engine->stream = LoadAudioStream(AudioConstants::SampleRate, 32, 2);
+		SetAudioStreamBufferSizeDefault(0);
+
+		if (!IsAudioStreamValid(engine->stream))
+		{
+			CloseAudioDevice();
+			return false;
+		}
+
+		callbackMixer = &engine->mixer;
+		SetAudioStreamCallback(engine->stream, &mix_callback);
+		PlayAudioStream(engine->stream);
+		return true;
+	}
+
+	void close_device()
+	{
+		// unloading waits for a running callback, after this the mixer is ours again
+		StopAudioStream(engine->stream);
+		UnloadAudioStream(engine->stream);
+		callbackMixer = nullptr;
+
+		CloseAudioDevice();
+	}
+}
+
+namespace AudioEngine
+{
+	void init(AudioOutput output, const std::string &wavPath)
+	{
+		if (engine != nullptr)
+		{
+			return;
+		}
+
+		engine = std::make_unique<EngineState>();
+		for (int i = 0; i < SoundEffectCount; i++)
+		{
+			engine->sounds[i] = SoundEffects::create(SoundEffect(i));
+		}
+
+		if (output == AudioOutput::DEVICE && !open_device())
+		{
+			TraceLog(LOG_WARNING, "Audio device couldn't be opened, continuing without sound");
+			output = AudioOutput::NONE;
+		}
+
+		if (output == AudioOutput::WAV_FILE && !engine->wavFile.open(wavPath))
+		{
+			TraceLog(LOG_WARNING, "Couldn't open %s for writing, continuing without sound", wavPath.c_str());
+			output = AudioOutput::NONE;
+		}
+
+		if (output != AudioOutput::DEVICE)
+		{
+			engine->buffer.resize(AudioConstants::BufferFrames * 2);
+		}
+
+		engine->output = output;
+	}
+
+	void shutdown()
+	{
+		if (engine == nullptr)
+		{
+			return;
+		}
+
+		stop_music();
+
+		auto metrics = get_metrics();
+		TraceLog(LOG_INFO,
+				 "Audio: peak %d voices, %d steals, %d rejected, %d dropped, queue latency %.2f ms (worst %.2f ms), %.2f us per voice",
+				 metrics.mixer.peakVoices,
+				 metrics.mixer.steals,
+				 metrics.mixer.rejected,
+				 metrics.mixer.dropped,
+				 metrics.mixer.averageQueueLatencyMs,
+				 metrics.mixer.maxQueueLatencyMs,
+				 metrics.mixer.voiceUs);
+
+		if (engine->output == AudioOutput::DEVICE)
+		{
+			close_device();
+		}
+		engine->wavFile.close();
+
+		engine = nullptr;
+	}
+
+	void update(float dt)
+	{
+		if (engine == nullptr)
+		{
+			return;
+		}
+
+		if (engine->musicLoaded)
+		{
+			UpdateMusicStream(engine->music);
+		}
+
+		if (engine->output == AudioOutput::DEVICE)
+		{
+			return;
+		}
+
+		// mix whole buffers like the device would, the remainder waits for the next frame
+		engine->pendingFrames += dt * AudioConstants::SampleRate;
+		while (engine->pendingFrames >= AudioConstants::BufferFrames)
+		{
+			engine->mixer.mix(engine->buffer.data(), AudioConstants::BufferFrames);
+			if (engine->output == AudioOutput::WAV_FILE)
+			{
+				engine->wavFile.write_frames(engine->buffer.data(), AudioConstants::BufferFrames);
+			}
+			engine->pendingFrames -= AudioConstants::BufferFrames;
+		}
+	}
+
+	void play(SoundEffect effect, float volume, float pan)
+	{
+		if (engine == nullptr)
+		{
+			return;
+		}
+
+		engine->mixer.submit({
+			.sound = &engine->sounds[int(effect)],
+			.priority = SoundEffects::get_priority(effect),
+			.volume = volume,
+			.pan = pan,
+			.requestedAt = AudioMixer::Clock::now(),
+		});
+	}
+
+	void stop_all_sounds()
+	{
+		if (engine == nullptr)
+		{
+			return;
+		}
+
+		engine->mixer.submit({.sound = nullptr});
+	}
+
+	void play_music(const std::string &path)
+	{
+		if (engine == nullptr)
+		{
+			return;
+		}
+
+		if (engine->output != AudioOutput::DEVICE)
+		{
+			TraceLog(LOG_INFO, "Music needs the audio device, not playing %s", path.c_str());
+			return;
+		}
+
+		stop_music();
+
+		// raylib decodes one chunk whenever a buffer runs dry, so the file is never loaded whole
+		SetAudioStreamBufferSizeDefault(AudioConstants::MusicChunkFrames);
+		engine->music = LoadMusicStream(path.c_str());
+		SetAudioStreamBufferSizeDefault(0);
+
+		if (!IsMusicValid(engine->music))
+		{
+			TraceLog(LOG_WARNING, "Couldn't stream music from %s", path.c_str());
+			return;
+		}
+
+		engine->musicLoaded = true;
+		PlayMusicStream(engine->music);
+	}
+
+	void stop_music()
+	{
+		if (engine == nullptr || !engine->musicLoaded)
+		{
+			return;
+		}
+
+		StopMusicStream(engine->music);
+		UnloadMusicStream(engine->music);
+		engine->musicLoaded = false;
+	}
+
+	Metrics get_metrics()
+	{
+		if (engine == nullptr)
+		{
+			return {};
+		}
+
+		// the device double buffers, the other outputs hand each buffer over right away
+		int buffersInFlight = engine->output == AudioOutput::DEVICE ? 2 : 1;
+
+		return {
+			.mixer = engine->mixer.get_metrics(),
+			.outputLatencyMs = buffersInFlight * AudioConstants::BufferFrames * 1000.0f / AudioConstants::SampleRate,
+			.musicPlaying = engine->musicLoaded,
+		};
+	}
+}
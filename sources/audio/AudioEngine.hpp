@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+
+#include "AudioMixer.hpp"
+#include "SoundEffects.hpp"
+
+enum class AudioOutput
+{
+    // raylib's audio device, mixed on the device's own thread
+    DEVICE,
+
+    // no output at all, the game loop drives the mixer so headless runs go
+    // through the same code as the game
+    NONE,
+
+    // like NONE, but whatever is mixed is written to a 16-bit WAV file
+    WAV_FILE,
+};
+
+/**
+ * Owns the audio output, the sound effects and the music. Sound effects are
+ * mixed by AudioMixer on a fixed pool of voices, music is streamed from disk
+ * a chunk at a time by raylib and only plays on the device.
+ *
+ * Everything in here is called from the game thread. Calls made before `init`
+ * (or in builds that never call it, like the benchmarks) do nothing.
+ */
+namespace AudioEngine
+{
+    struct Metrics
+    {
+        AudioMixer::Metrics mixer;
+
+        // time from the mixer writing a sample to it being played
+        float outputLatencyMs = 0;
+
+        bool musicPlaying = false;
+    };
+
+    // Falls back to AudioOutput::NONE if the device or the file can't be opened
+    void init(AudioOutput output, const std::string &wavPath = {});
+    void shutdown();
+
+    // Once per frame: refills the music stream, and mixes `dt` worth of
+    // sound when there is no device to ask for it
+    void update(float dt);
+
+    // `pan` goes from -1 (left) to 1 (right)
+    void play(SoundEffect effect, float volume = 1.0f, float pan = 0.0f);
+    void stop_all_sounds();
+
+    // Loops the file until stopped, any format raylib can stream
+    void play_music(const std::string &path);
+    void stop_music();
+
+    Metrics get_metrics();
+}
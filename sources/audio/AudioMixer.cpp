@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cmath>
+
+#include <raylib.h>
+
+#include "AudioMixer.hpp"
+
+namespace
+{
+	// weight of the newest sample in the running averages
+	constexpr float MetricSmoothing = 0.05f;
+
+	void smooth(std::atomic<float> &average, float value)
+	{
+		float current = average.load(std::memory_order_relaxed);
+		average.store(current + (value - current) * MetricSmoothing, std::memory_order_relaxed);
+	}
+}
+
+int SoundData::frame_count() const
+{
+	return int(samples.size() / 2);
+}
+
+bool AudioMixer::submit(const PlayRequest &request)
+{
+	if (!requests.push(request))
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	return true;
+}
+
+AudioMixer::Voice *AudioMixer::find_voice(int priority)
+{
+	Voice *candidate = nullptr;
+	for (auto &&voice : voices)
+	{
+		if (voice.sound == nullptr)
+		{
+			return &voice;
+		}
+
+		// lowest priority first, the oldest of those since it's closest to being done anyway
+		if (candidate == nullptr ||
+			voice.priority < candidate->priority ||
+			(voice.priority == candidate->priority && voice.serial < candidate->serial))
+		{
+			candidate = &voice;
+		}
+	}
+
+	// never cut off something more important than the new sound
+	if (candidate->priority > priority)
+	{
+		return nullptr;
+	}
+
+	steals.fetch_add(1, std::memory_order_relaxed);
+	return candidate;
+}
+
+void AudioMixer::start_queued_voices(Clock::time_point now)
+{
+	PlayRequest request;
+	while (requests.pop(request))
+	{
+		if (request.sound == nullptr)
+		{
+			for (auto &&voice : voices)
+			{
+				voice.sound = nullptr;
+			}
+			continue;
+		}
+
+		Voice *voice = find_voice(request.priority);
+		if (voice == nullptr)
+		{
+			rejected.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		// equal power panning, so a sound is as loud in the middle as on either side
+		float angle = (std::clamp(request.pan, -1.0f, 1.0f) + 1.0f) * PI / 4.0f;
+		*voice = {
+			.sound = request.sound,
+			.frame = 0,
+			.priority = request.priority,
+			.gainLeft = request.volume * std::cos(angle),
+			.gainRight = request.volume * std::sin(angle),
+			.serial = nextSerial++,
+		};
+
+		float latencyMs = std::chrono::duration<float, std::milli>(now - request.requestedAt).count();
+		smooth(averageQueueLatencyMs, latencyMs);
+		if (latencyMs > maxQueueLatencyMs.load(std::memory_order_relaxed))
+		{
+			maxQueueLatencyMs.store(latencyMs, std::memory_order_relaxed);
+		}
+	}
+}
+
+void AudioMixer::mix(float *output, int frames)
+{
+	auto start = Clock::now();
+	start_queued_voices(start);
+
+	std::fill_n(output, frames * 2, 0.0f);
+
+	int active = 0;
+	for (auto &&voice : voices)
+	{
+		if (voice.sound == nullptr)
+		{
+			continue;
+		}
+
+		active++;
+		const float *samples = voice.sound->samples.data() + voice.frame * 2;
+		int count = std::min(frames, voice.sound->frame_count() - voice.frame);
+
+		for (int i = 0; i < count; i++)
+		{
+			output[i * 2] += samples[i * 2] * voice.gainLeft;
+			output[i * 2 + 1] += samples[i * 2 + 1] * voice.gainRight;
+		}
+
+		voice.frame += count;
+		if (voice.frame >= voice.sound->frame_count())
+		{
+			voice.sound = nullptr;
+		}
+	}
+
+	// many loud voices at once would wrap around in the device's integer format
+	for (int i = 0; i < frames * 2; i++)
+	{
+		output[i] = std::clamp(output[i], -1.0f, 1.0f);
+	}
+
+	float elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	smooth(mixMs, elapsedMs);
+	if (active > 0)
+	{
+		smooth(voiceUs, elapsedMs * 1000.0f / active);
+	}
+
+	activeVoices.store(active, std::memory_order_relaxed);
+	if (active > peakVoices.load(std::memory_order_relaxed))
+	{
+		peakVoices.store(active, std::memory_order_relaxed);
+	}
+}
+
+AudioMixer::Metrics AudioMixer::get_metrics() const
+{
+	return {
+		.activeVoices = activeVoices.load(std::memory_order_relaxed),
+		.peakVoices = peakVoices.load(std::memory_order_relaxed),
+		.steals = steals.load(std::memory_order_relaxed),
+		.rejected = rejected.load(std::memory_order_relaxed),
+		.dropped = dropped.load(std::memory_order_relaxed),
+		.averageQueueLatencyMs = averageQueueLatencyMs.load(std::memory_order_relaxed),
+		.maxQueueLatencyMs = maxQueueLatencyMs.load(std::memory_order_relaxed),
+		.mixMs = mixMs.load(std::memory_order_relaxed),
+		.voiceUs = voiceUs.load(std::memory_order_relaxed),
+	};
+}
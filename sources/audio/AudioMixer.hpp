@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <Constants.hpp>
+#include <utils/SpscQueue.hpp>
+
+// Decoded sound, interleaved stereo float samples at AudioConstants::SampleRate
+struct SoundData
+{
+    std::vector<float> samples;
+
+    int frame_count() const;
+};
+
+/**
+ * Mixes sound effects into a stereo float buffer. The mixer doesn't know about
+ * any audio device, whoever owns the output calls `mix` (the device callback,
+ * or the game loop when there is no device, see AudioEngine).
+ *
+ * `submit` is called from the game thread and `mix` from the output thread,
+ * they only talk through a lock-free queue, so neither one ever waits for the
+ * other. Sounds passed to `submit` must stay alive while they may be playing.
+ */
+class AudioMixer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct PlayRequest
+    {
+        // nullptr stops every voice
+        const SoundData *sound = nullptr;
+        int priority = 0;
+        float volume = 1.0f;
+
+        // -1 is fully left, 1 fully right
+        float pan = 0.0f;
+
+        Clock::time_point requestedAt;
+    };
+
+    struct Metrics
+    {
+        int activeVoices = 0;
+        int peakVoices = 0;
+
+        // voices taken from a playing sound, requests that lost against every
+        // playing sound and requests that didn't fit in the queue
+        int steals = 0;
+        int rejected = 0;
+        int dropped = 0;
+
+        // time from `submit` to the mix the sound started in, averaged and worst
+        float averageQueueLatencyMs = 0;
+        float maxQueueLatencyMs = 0;
+
+        // CPU time of a `mix` call and its share per active voice, averaged
+        float mixMs = 0;
+        float voiceUs = 0;
+    };
+
+private:
+    struct Voice
+    {
+        const SoundData *sound = nullptr;
+        int frame = 0;
+        int priority = 0;
+        float gainLeft = 0;
+        float gainRight = 0;
+
+        // order voices were started in, the oldest is stolen first
+        uint64_t serial = 0;
+    };
+
+    SpscQueue<PlayRequest, AudioConstants::RequestQueueSize> requests;
+    std::array<Voice, AudioConstants::VoiceCount> voices{};
+    uint64_t nextSerial = 0;
+
+    // written by the output thread (`dropped` by the game thread), read by anyone
+    std::atomic<int> activeVoices{0};
+    std::atomic<int> peakVoices{0};
+    std::atomic<int> steals{0};
+    std::atomic<int> rejected{0};
+    std::atomic<int> dropped{0};
+    std::atomic<float> averageQueueLatencyMs{0};
+    std::atomic<float> maxQueueLatencyMs{0};
+    std::atomic<float> mixMs{0};
+    std::atomic<float> voiceUs{0};
+
+    void start_queued_voices(Clock::time_point now);
+    Voice *find_voice(int priority);
+
+public:
+    // Game thread, returns false when the request queue is full
+    bool submit(const PlayRequest &request);
+
+    // Output thread, overwrites `frames` stereo frames of `output`
+    void mix(float *output, int frames);
+
+    Metrics get_metrics() const;
+};
@@ -0,0 +1,75 @@
+#include <cmath>
+
+#include <Constants.hpp>
+
+#include "SoundEffects.hpp"
+
+namespace
+{
+	struct ToneSettings
+	{
+		float startHz;
+		float endHz;
+		float duration;
+		float volume;
+
+		// amplitude left at the end of the sound, the rest decays exponentially
+		float tail;
+	};
+
+	// square wave with an exponential pitch sweep, the classic platformer blip
+	SoundData create_tone(const ToneSettings &settings)
+	{
+		SoundData sound;
+		int frames = int(settings.duration * AudioConstants::SampleRate);
+		sound.samples.resize(frames * 2);
+
+		float phase = 0;
+		for (int i = 0; i < frames; i++)
+		{
+			float t = float(i) / frames;
+			float hz = settings.startHz * std::pow(settings.endHz / settings.startHz, t);
+			phase = std::fmod(phase + hz / AudioConstants::SampleRate, 1.0f);
+
+			float envelope = settings.volume * std::pow(settings.tail, t);
+			float sample = (phase < 0.5f ? 1.0f : -1.0f) * envelope;
+			sound.samples[i * 2] = sample;
+			sound.samples[i * 2 + 1] = sample;
+		}
+
+		return sound;
+	}
+}
+
+namespace SoundEffects
+{
+	int get_priority(SoundEffect effect)
+	{
+		switch (effect)
+		{
+		case SoundEffect::RESPAWN:
+			return 3;
+		case SoundEffect::JUMP:
+			return 2;
+		case SoundEffect::LAND:
+			return 1;
+		}
+
+		return 0;
+	}
+
+	SoundData create(SoundEffect effect)
+	{
+		switch (effect)
+		{
+		case SoundEffect::JUMP:
+			return create_tone({.startHz = 300, .endHz = 700, .duration = 0.12f, .volume = 0.25f, .tail = 0.2f});
+		case SoundEffect::LAND:
+			return create_tone({.startHz = 140, .endHz = 60, .duration = 0.08f, .volume = 0.3f, .tail = 0.05f});
+		case SoundEffect::RESPAWN:
+			return create_tone({.startHz = 600, .endHz = 120, .duration = 0.4f, .volume = 0.25f, .tail = 0.1f});
+		}
+
+		return {};
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "AudioMixer.hpp"
+
+enum class SoundEffect
+{
+    JUMP,
+    LAND,
+    RESPAWN,
+};
+
+constexpr int SoundEffectCount = 3;
+
+// Every sound effect the game plays, gameplay code asks AudioEngine to play
+// one of these instead of loading sounds itself
+namespace SoundEffects
+{
+    // Higher priority sounds steal voices from lower priority ones
+    int get_priority(SoundEffect effect);
+
+    // There are no sound assets yet, so effects are synthesized at startup
+    SoundData create(SoundEffect effect);
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <raylib.h>
+
+#include <Constants.hpp>
+
+#include "Benchmarks.hpp"
+#include "../entities/Actors/ActorSystem.hpp"
+#include "../physics/CollisionGrid.hpp"
+
+namespace
+{
+	constexpr int ActorCount = 1024;
+
+	// a long strip of ground with actors spread along it, the camera sits at
+	// one end so there are near, mid and far actors
+	constexpr int GridWidth = 512;
+	constexpr int GridHeight = 8;
+
+	CollisionGrid &get_grid()
+	{
+		static CollisionGrid grid = []
+		{
+			CollisionGrid ground(GridWidth, GridHeight);
+			for (int x = 0; x < GridWidth; x++)
+			{
+				ground.set_solid(x, GridHeight - 1, true);
+			}
+			return ground;
+		}();
+
+		return grid;
+	}
+
+	void fill(ActorSystem &actors)
+	{
+		const float cellSize = GameConstants::CellSize;
+		const float groundY = (GridHeight - 1) * cellSize;
+
+		for (int i = 0; i < ActorCount; i++)
+		{
+			float x = (i * GridWidth / (float)ActorCount) * cellSize;
+
+			if (i % 2 == 0)
+			{
+				actors.add(ActorDefinition::from_kind(ActorKind::PATROL, {x, groundY - 32, 32, 32}));
+				continue;
+			}
+
+			auto saw = ActorDefinition::from_kind(ActorKind::SAW, {x, groundY - 80, 38, 38});
+			saw.movement = ActorMovement::PATH;
+			saw.path.push_back({x + 64, groundY - 80});
+			saw.path.push_back({x + 64, groundY - 120});
+			actors.add(saw);
+		}
+	}
+
+	void run_ticks(float tickBudgetMs, int iterations)
+	{
+		ActorSystem actors(tickBudgetMs);
+		actors.set_world(nullptr, &get_grid());
+		fill(actors);
+
+		for (int i = 0; i < iterations; i++)
+		{
+			actors.update(GameConstants::TickDuration, {0, 0}, {});
+		}
+		Benchmarks::do_not_optimize(actors.get_metrics().updated);
+	}
+
+	void actors_update_budgeted(int iterations)
+	{
+		run_ticks(ActorConstants::TickBudgetMs, iterations);
+	}
+
+	void actors_update_unbudgeted(int iterations)
+	{
+		run_ticks(ActorConstants::UnlimitedBudgetMs, iterations);
+	}
+
+	Benchmarks::Registrar budgeted("actors_update_budgeted", &actors_update_budgeted, 600, ActorCount);
+	Benchmarks::Registrar unbudgeted("actors_update_unbudgeted", &actors_update_unbudgeted, 600, ActorCount);
+}
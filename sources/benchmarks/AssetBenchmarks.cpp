@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <string_view>
+
+#include <raylib.h>
+
+#include <utils/AssetRegistry.hpp>
+#include <utils/CookedTexture.hpp>
+
+#include "Benchmarks.hpp"
+
+namespace
+{
+	// the textures registered in AssetRegistry, the same filter the
+	// cook-assets target applies to the registry
+	constexpr bool is_texture(std::string_view name)
+	{
+		return name.ends_with(".png");
+	}
+
+	constexpr size_t TextureCount = std::count_if(AssetRegistry::Names.begin(), AssetRegistry::Names.end(), is_texture);
+
+	constexpr std::array<AssetId, TextureCount> Textures = []
+	{
+		std::array<AssetId, TextureCount> textures{};
+		size_t count = 0;
+		for (size_t i = 0; i < AssetRegistry::Count; i++)
+		{
+			if (is_texture(AssetRegistry::Names[i]))
+			{
+				textures[count++] = AssetId(i);
+			}
+		}
+		return textures;
+	}();
+
+	void load_png_textures(int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto asset : Textures)
+			{
+				Texture2D texture = LoadTexture(AssetRegistry::get_path(asset));
+				UnloadTexture(texture);
+			}
+		}
+	}
+
+	void load_cooked_textures(int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto asset : Textures)
+			{
+				Image image = CookedTexture::load_image(AssetRegistry::get_cooked_path(asset));
+				if (image.data == nullptr)
+				{
+					std::fprintf(stderr, "%s isn't cooked, run the cook-assets target first\n", AssetRegistry::get_path(asset));
+					continue;
+				}
+
+				Texture2D texture = LoadTextureFromImage(image);
+				UnloadImage(image);
+				UnloadTexture(texture);
+			}
+		}
+	}
+
+	Benchmarks::Registrar pngLoad("asset_load_png", &load_png_textures, 50, Textures.size());
+	Benchmarks::Registrar cookedLoad("asset_load_cooked", &load_cooked_textures, 50, Textures.size());
+}
@@ -0,0 +1,59 @@
+#include <vector>
+
+#include <Constants.hpp>
+
+#include "Benchmarks.hpp"
+#include "../audio/AudioMixer.hpp"
+#include "../audio/SoundEffects.hpp"
+
+namespace
+{
+	// mixes without any audio device, so this runs on machines without sound too
+	struct AudioFixture
+	{
+		AudioMixer mixer;
+		SoundData longSound;
+		SoundData jumpSound;
+		std::vector<float> buffer;
+
+		AudioFixture() : jumpSound(SoundEffects::create(SoundEffect::JUMP))
+		{
+			// long enough that voices don't end while a benchmark runs
+			longSound.samples.assign(AudioConstants::SampleRate * 60 * 2, 0.1f);
+			buffer.resize(AudioConstants::BufferFrames * 2);
+		}
+	};
+
+	// one device callback with every voice busy
+	void audio_mix_full_pool(AudioFixture &fixture, int iterations)
+	{
+		fixture.mixer.submit({.sound = nullptr});
+		for (int i = 0; i < AudioConstants::VoiceCount; i++)
+		{
+			fixture.mixer.submit({.sound = &fixture.longSound, .requestedAt = AudioMixer::Clock::now()});
+		}
+
+		for (int i = 0; i < iterations; i++)
+		{
+			fixture.mixer.mix(fixture.buffer.data(), AudioConstants::BufferFrames);
+		}
+		Benchmarks::do_not_optimize(fixture.buffer[0]);
+	}
+
+	// a burst of short effects on a full pool, every request has to steal a voice
+	void audio_voice_stealing(AudioFixture &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			for (int voice = 0; voice < AudioConstants::VoiceCount; voice++)
+			{
+				fixture.mixer.submit({.sound = &fixture.jumpSound, .requestedAt = AudioMixer::Clock::now()});
+			}
+			fixture.mixer.mix(fixture.buffer.data(), AudioConstants::BufferFrames);
+		}
+		Benchmarks::do_not_optimize(fixture.buffer[0]);
+	}
+
+	Benchmarks::Registrar mixFullPool("audio_mix_full_pool", &audio_mix_full_pool, 10000, AudioConstants::VoiceCount);
+	Benchmarks::Registrar voiceStealing("audio_voice_stealing", &audio_voice_stealing, 10000, AudioConstants::VoiceCount);
+}
@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <utils/Simd.hpp>
+
+#include "Benchmarks.hpp"
+
+namespace
+{
+	struct Benchmark
+	{
+		const char *name;
+		Benchmarks::Runner runner;
+		int iterations;
+		int itemsPerIteration;
+	};
+
+	// function-local so it's initialized before the first static Registrar uses it
+	std::vector<Benchmark> &registry()
+	{
+		static std::vector<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	struct Result
+	{
+		const char *name;
+		int iterations;
+		double totalMs;
+		double nsPerIteration;
+		double nsPerItem;
+	};
+
+	// benchmark names are plain identifiers, so nothing in here needs escaping
+	bool write_json(const std::string &path, const std::vector<Result> &results)
+	{
+		FILE *file = std::fopen(path.c_str(), "w");
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		std::fprintf(file, "{\n");
+		std::fprintf(file, "  \"simd_backend\": \"%s\",\n", Simd::backend_name());
+		std::fprintf(file, "  \"benchmarks\": [\n");
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const auto &result = results[i];
+			std::fprintf(file,
+						 "    {\"name\": \"%s\", \"iterations\": %d, \"total_ms\": %.3f, \"ns_per_iteration\": %.1f, \"ns_per_item\": %.3f}%s\n",
+						 result.name,
+						 result.iterations,
+						 result.totalMs,
+						 result.nsPerIteration,
+						 result.nsPerItem,
+						 i + 1 < results.size() ? "," : "");
+		}
+		std::fprintf(file, "  ]\n");
+		std::fprintf(file, "}\n");
+
+		return std::fclose(file) == 0;
+	}
+}
+
+namespace Benchmarks
+{
+	Registrar::Registrar(const char *name, Function function, int iterations, int itemsPerIteration)
+		: Registrar(name, Runner([function](int iterations) { return time_after_warmup(function, iterations); }), iterations, itemsPerIteration)
+	{
+	}
+
+	Registrar::Registrar(const char *name, Runner runner, int iterations, int itemsPerIteration)
+	{
+		registry().push_back({name, std::move(runner), iterations, itemsPerIteration});
+	}
+
+	int run(std::string_view filter, std::string_view jsonPath)
+	{
+		std::printf("SIMD backend: %s\n", Simd::backend_name());
+		std::printf("%-40s %12s %14s %14s %12s\n", "benchmark", "iterations", "total (ms)", "ns/iteration", "ns/item");
+
+		std::vector<Result> results;
+		for (auto &&benchmark : registry())
+		{
+			if (std::string_view(benchmark.name).find(filter) == std::string_view::npos)
+			{
+				continue;
+			}
+
+			double totalNs = benchmark.runner(benchmark.iterations);
+			double perIteration = totalNs / benchmark.iterations;
+			double perItem = perIteration / benchmark.itemsPerIteration;
+
+			std::printf("%-40s %12d %14.3f %14.1f %12.3f\n",
+						benchmark.name,
+						benchmark.iterations,
+						totalNs / 1e6,
+						perIteration,
+						perItem);
+			results.push_back({benchmark.name, benchmark.iterations, totalNs / 1e6, perIteration, perItem});
+		}
+
+		if (results.empty())
+		{
+			std::fprintf(stderr, "No benchmark matches '%.*s'\n", (int)filter.size(), filter.data());
+			return EXIT_FAILURE;
+		}
+
+		if (!jsonPath.empty() && !write_json(std::string(jsonPath), results))
+		{
+			std::fprintf(stderr, "Couldn't write benchmark results to '%.*s'\n", (int)jsonPath.size(), jsonPath.data());
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string_view>
+
+/**
+ * Tiny microbenchmark harness, the `benchmarks` executable runs it with
+ * `benchmarks [filter]`. Benchmarks register themselves from their own
+ * translation unit with a static `Benchmarks::Registrar`, and run inside a
+ * hidden window so they can use raylib resources too.
+ *
+ * Benchmarks that need something set up first take a fixture, which is built
+ * for that benchmark alone outside of the timing and destroyed once it's done,
+ * so nothing carries over from one benchmark to the next.
+ *
+ * `--json <path>` also writes the results to a JSON file, so runs from
+ * different commits can be compared by a script.
+ */
+namespace Benchmarks
+{
+    // Runs the benchmarked workload `iterations` times
+    using Function = void (*)(int iterations);
+
+    // Runs a benchmark once to warm caches and lazily initialized state, then
+    // `iterations` more times, and returns how long the latter took in nanoseconds
+    using Runner = std::function<double(int iterations)>;
+
+    template <typename Workload>
+    double time_after_warmup(Workload &&workload, int iterations)
+    {
+        workload(1);
+
+        auto start = std::chrono::steady_clock::now();
+        workload(iterations);
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    struct Registrar
+    {
+        // `itemsPerIteration` is used to also report the cost per item (particle, query, ...)
+        Registrar(const char *name, Function function, int iterations, int itemsPerIteration = 1);
+
+        // The warm-up and the timed run share one default constructed `Fixture`
+        template <typename Fixture>
+        Registrar(const char *name, void (*function)(Fixture &fixture, int iterations), int iterations, int itemsPerIteration = 1)
+            : Registrar(name,
+                        Runner([function](int iterations) {
+                            Fixture fixture;
+                            return time_after_warmup([&](int count) { function(fixture, count); }, iterations);
+                        }),
+                        iterations,
+                        itemsPerIteration)
+        {
+        }
+
+    private:
+        Registrar(const char *name, Runner runner, int iterations, int itemsPerIteration);
+    };
+
+    // Runs every benchmark whose name contains `filter`, returns the process exit code.
+    // The results are also written to `jsonPath` unless it's empty.
+    int run(std::string_view filter, std::string_view jsonPath = {});
+
+    // Keeps the compiler from optimizing away a value that is otherwise unused
+    template <typename T>
+    inline void do_not_optimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        volatile const T *sink = &value;
+        (void)sink;
+#endif
+    }
+}
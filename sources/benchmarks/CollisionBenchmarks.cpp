@@ -0,0 +1,150 @@
+#include <memory>
+#include <vector>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/Project.hpp>
+
+#include <Constants.hpp>
+#include <utils/AssetRegistry.hpp>
+
+#include "Benchmarks.hpp"
+#include "../physics/CollisionGrid.hpp"
+#include "../physics/LevelColliders.hpp"
+#include "../physics/PhysicsTypes.hpp"
+#include "../physics/RaycastUtils.hpp"
+
+namespace
+{
+	constexpr int ProbesPerAxis = 32;
+	constexpr int ProbeCount = ProbesPerAxis * ProbesPerAxis;
+
+	// first level of the game world, loaded into both collision representations
+	struct CollisionFixture
+	{
+		ldtk::Project project;
+		std::unique_ptr<b2World> world;
+		CollisionGrid grid;
+		std::vector<Vector2> probes;
+
+		CollisionFixture()
+		{
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+			const auto *level = &project.getWorld().getLevel(0);
+
+			world = std::make_unique<b2World>(b2Vec2(0.0f, 60.0f));
+			LevelColliders::create(level, world.get());
+			grid = CollisionGrid::from_level(level);
+
+			// evenly spread probe points over the whole level
+			for (int y = 0; y < ProbesPerAxis; y++)
+			{
+				for (int x = 0; x < ProbesPerAxis; x++)
+				{
+					probes.push_back({(x + 0.5f) * level->size.x / ProbesPerAxis,
+									  (y + 0.5f) * level->size.y / ProbesPerAxis});
+				}
+			}
+		}
+	};
+
+	// the same ground check Player does, a short raycast straight down
+	void ground_check_box2d(CollisionFixture &fixture, int iterations)
+	{
+		const float scale = GameConstants::PhysicsWorldScale;
+
+		int hits = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto &&probe : fixture.probes)
+			{
+				b2Vec2 source = {probe.x / scale, probe.y / scale};
+				b2Vec2 target = {source.x, source.y + 1.1f};
+				hits += RaycastCheckCollisionWithUserData(fixture.world.get(), source, target, PhysicsTypes::SolidBlock);
+			}
+		}
+		Benchmarks::do_not_optimize(hits);
+	}
+
+	void ground_check_grid(CollisionFixture &fixture, int iterations)
+	{
+		int hits = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto &&probe : fixture.probes)
+			{
+				hits += fixture.grid.is_on_ground({probe.x - 8, probe.y - 8, 16, 16}, 1.1f * GameConstants::PhysicsWorldScale);
+			}
+		}
+		Benchmarks::do_not_optimize(hits);
+	}
+
+	void wall_check_box2d(CollisionFixture &fixture, int iterations)
+	{
+		const float scale = GameConstants::PhysicsWorldScale;
+
+		int hits = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto &&probe : fixture.probes)
+			{
+				b2Vec2 source = {probe.x / scale, probe.y / scale};
+				b2Vec2 target = {source.x + 1.1f, source.y};
+				hits += RaycastCheckCollisionWithUserData(fixture.world.get(), source, target, PhysicsTypes::SolidBlock);
+			}
+		}
+		Benchmarks::do_not_optimize(hits);
+	}
+
+	void wall_check_grid(CollisionFixture &fixture, int iterations)
+	{
+		int hits = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto &&probe : fixture.probes)
+			{
+				hits += fixture.grid.is_against_wall({probe.x - 8, probe.y - 8, 16, 16}, true, 1.1f * GameConstants::PhysicsWorldScale);
+			}
+		}
+		Benchmarks::do_not_optimize(hits);
+	}
+
+	// long diagonal rays that usually cross several colliders before the nearest hit is known
+	void raycast_nearest_box2d(CollisionFixture &fixture, int iterations)
+	{
+		const float scale = GameConstants::PhysicsWorldScale;
+
+		int hits = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto &&probe : fixture.probes)
+			{
+				b2Vec2 source = {probe.x / scale, probe.y / scale};
+				b2Vec2 target = {source.x + 8.0f, source.y + 8.0f};
+				hits += RaycastGetFirstFixtureFromSourceToTarget(fixture.world.get(), source, target) != nullptr;
+			}
+		}
+		Benchmarks::do_not_optimize(hits);
+	}
+
+	void sweep_grid(CollisionFixture &fixture, int iterations)
+	{
+		float travelled = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto &&probe : fixture.probes)
+			{
+				auto result = fixture.grid.sweep({probe.x - 4, probe.y - 4, 8, 8}, {24.0f, 24.0f});
+				travelled += result.rect.x;
+			}
+		}
+		Benchmarks::do_not_optimize(travelled);
+	}
+
+	Benchmarks::Registrar groundBox2d("collision_ground_check_box2d", &ground_check_box2d, 1000, ProbeCount);
+	Benchmarks::Registrar groundGrid("collision_ground_check_grid", &ground_check_grid, 1000, ProbeCount);
+	Benchmarks::Registrar wallBox2d("collision_wall_check_box2d", &wall_check_box2d, 1000, ProbeCount);
+	Benchmarks::Registrar wallGrid("collision_wall_check_grid", &wall_check_grid, 1000, ProbeCount);
+	Benchmarks::Registrar raycastBox2d("collision_raycast_nearest_box2d", &raycast_nearest_box2d, 1000, ProbeCount);
+	Benchmarks::Registrar sweepGrid("collision_sweep_grid", &sweep_grid, 1000, ProbeCount);
+}
@@ -0,0 +1,64 @@
+#include <memory>
+
+#include <box2d/box2d.h>
+#include <LDtkLoader/Project.hpp>
+
+#include <utils/AssetRegistry.hpp>
+
+#include "Benchmarks.hpp"
+#include "../physics/CollisionGrid.hpp"
+#include "../physics/LevelColliders.hpp"
+
+namespace
+{
+	struct LevelFixture
+	{
+		ldtk::Project project;
+		std::unique_ptr<b2World> world;
+
+		LevelFixture()
+		{
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+			world = std::make_unique<b2World>(b2Vec2(0.0f, 60.0f));
+		}
+
+		const ldtk::Level *get_level() const
+		{
+			return &project.getWorld().getLevel(0);
+		}
+	};
+
+	// parsing the whole LDtk project, what every scene and simulation pays up-front
+	void level_load(int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			ldtk::Project project;
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+			Benchmarks::do_not_optimize(project.getWorld().allLevels().size());
+		}
+	}
+
+	// the colliders are destroyed again so the world doesn't grow between iterations
+	void level_colliders_create(LevelFixture &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			auto bodies = LevelColliders::create(fixture.get_level(), fixture.world.get(), {0, 0}, false);
+			LevelColliders::destroy(bodies, fixture.world.get());
+		}
+	}
+
+	void level_collision_grid_build(LevelFixture &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			auto grid = CollisionGrid::from_level(fixture.get_level());
+			Benchmarks::do_not_optimize(grid);
+		}
+	}
+
+	Benchmarks::Registrar load("level_load_ldtk_project", &level_load, 20);
+	Benchmarks::Registrar colliders("level_colliders_create", &level_colliders_create, 1000);
+	Benchmarks::Registrar grid("level_collision_grid_build", &level_collision_grid_build, 1000);
+}
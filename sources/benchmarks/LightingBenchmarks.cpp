@@ -0,0 +1,95 @@
+#include <vector>
+
+#include <raylib.h>
+#include <LDtkLoader/Project.hpp>
+
+#include <Constants.hpp>
+#include <utils/AssetRegistry.hpp>
+
+#include "Benchmarks.hpp"
+#include "../lighting/LightingSystem.hpp"
+#include "../lighting/ShadowCaster.hpp"
+#include "../physics/CollisionGrid.hpp"
+#include "../rendering/RenderTargetStack.hpp"
+
+namespace
+{
+	constexpr int LightCount = 32;
+
+	struct LightingFixture
+	{
+		ldtk::Project project;
+		CollisionGrid grid;
+		ShadowCaster shadowCaster;
+
+		LightingFixture()
+		{
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+			grid = CollisionGrid::from_level(&project.getWorld().getLevel(0));
+			shadowCaster.set_occluders(grid);
+		}
+	};
+
+	// lights spread over the whole level, so every one of them is on screen
+	template <bool IsStatic>
+	struct LightingDrawFixture : LightingFixture
+	{
+		LightingSystem lighting;
+		// lights are multiplied onto the game's target, at full resolution here
+		RenderTexture2D sceneTarget = LoadRenderTexture(GameConstants::WorldWidth, GameConstants::WorldHeight);
+
+		LightingDrawFixture()
+		{
+			lighting.set_occluders(grid);
+			for (int i = 0; i < LightCount; i++)
+			{
+				lighting.add_light({
+					.position = {
+						(i % 8 + 0.5f) * GameConstants::WorldWidth / 8.0f,
+						(i / 8 + 0.5f) * GameConstants::WorldHeight / 4.0f,
+					},
+					.radius = LightingConstants::DefaultLightRadius,
+					.color = WHITE,
+					.isStatic = IsStatic,
+				});
+			}
+		}
+
+		~LightingDrawFixture()
+		{
+			UnloadRenderTexture(sceneTarget);
+		}
+	};
+
+	void lighting_visibility_polygon(LightingFixture &fixture, int iterations)
+	{
+		std::vector<Vector2> polygon;
+
+		for (int i = 0; i < iterations; i++)
+		{
+			fixture.shadowCaster.compute({GameConstants::WorldWidth / 2.0f, GameConstants::WorldHeight / 2.0f},
+										 LightingConstants::PlayerLightRadius,
+										 polygon);
+			Benchmarks::do_not_optimize(polygon.data());
+		}
+	}
+
+	// static lights have their polygons computed on the first frame and reused
+	// on every other one, dynamic ones recompute them every frame
+	template <bool IsStatic>
+	void lighting_draw(LightingDrawFixture<IsStatic> &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			BeginDrawing();
+			RenderTargetStack::push(fixture.sceneTarget);
+			fixture.lighting.draw({.zoom = 1.0f});
+			RenderTargetStack::pop();
+			EndDrawing();
+		}
+	}
+
+	Benchmarks::Registrar visibility("lighting_visibility_polygon", &lighting_visibility_polygon, 10000);
+	Benchmarks::Registrar staticLights("lighting_draw_static_lights", &lighting_draw<true>, 200, LightCount);
+	Benchmarks::Registrar dynamicLights("lighting_draw_dynamic_lights", &lighting_draw<false>, 200, LightCount);
+}
@@ -0,0 +1,106 @@
+#include <memory>
+
+#include <raylib.h>
+
+#include <Constants.hpp>
+
+#include "Benchmarks.hpp"
+#include "../navigation/FlowField.hpp"
+#include "../navigation/NavigationGraph.hpp"
+#include "../physics/CollisionGrid.hpp"
+
+namespace
+{
+	constexpr int AgentCount = 4096;
+
+	// ground with pits, and staggered platforms above it that need jumps to reach
+	CollisionGrid create_level(int width, int height)
+	{
+		CollisionGrid grid(width, height);
+		for (int x = 0; x < width; x++)
+		{
+			if (x % 16 < 14)
+			{
+				grid.set_solid(x, height - 1, true);
+			}
+
+			for (int y = height - 4; y > 2; y -= 3)
+			{
+				if ((x + y * 3) % 12 < 5)
+				{
+					grid.set_solid(x, y, true);
+				}
+			}
+		}
+		return grid;
+	}
+
+	template <int Width, int Height>
+	struct NavigationFixture
+	{
+		CollisionGrid grid = create_level(Width, Height);
+		NavigationGraph graph = NavigationGraph::from_grid(grid);
+		std::unique_ptr<FlowField> field;
+
+		NavigationFixture()
+		{
+			field = std::make_unique<FlowField>(&graph);
+			field->begin(graph.find_node({Width * GameConstants::CellSize / 2.0f, (Height - 2) * float(GameConstants::CellSize)}));
+			field->advance(graph.get_node_count());
+		}
+	};
+
+	template <int Width, int Height>
+	void graph_build(NavigationFixture<Width, Height> &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			auto graph = NavigationGraph::from_grid(fixture.grid);
+			Benchmarks::do_not_optimize(graph);
+		}
+	}
+
+	// a full rebuild towards a target that moves every time, what the worker does
+	template <int Width, int Height>
+	void field_rebuild(NavigationFixture<Width, Height> &fixture, int iterations)
+	{
+		FlowField field(&fixture.graph);
+		for (int i = 0; i < iterations; i++)
+		{
+			field.begin(i % fixture.graph.get_node_count());
+			field.advance(fixture.graph.get_node_count());
+		}
+		Benchmarks::do_not_optimize(field.is_complete());
+	}
+
+	// agents spread over the whole level each asking where to go next
+	template <int Width, int Height>
+	void field_query(NavigationFixture<Width, Height> &fixture, int iterations)
+	{
+		const float levelWidth = Width * GameConstants::CellSize;
+		const float levelHeight = Height * GameConstants::CellSize;
+
+		int reachable = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (int agent = 0; agent < AgentCount; agent++)
+			{
+				Vector2 position = {(agent * 37 % 1024) * levelWidth / 1024, (agent * 91 % 1024) * levelHeight / 1024};
+				reachable += fixture.field->get_step(position).node >= 0;
+			}
+		}
+		Benchmarks::do_not_optimize(reachable);
+	}
+
+	Benchmarks::Registrar graphSmall("navigation_graph_build_64x32", &graph_build<64, 32>, 100);
+	Benchmarks::Registrar graphMedium("navigation_graph_build_256x64", &graph_build<256, 64>, 20);
+	Benchmarks::Registrar graphLarge("navigation_graph_build_1024x128", &graph_build<1024, 128>, 5);
+
+	Benchmarks::Registrar rebuildSmall("navigation_field_rebuild_64x32", &field_rebuild<64, 32>, 1000);
+	Benchmarks::Registrar rebuildMedium("navigation_field_rebuild_256x64", &field_rebuild<256, 64>, 200);
+	Benchmarks::Registrar rebuildLarge("navigation_field_rebuild_1024x128", &field_rebuild<1024, 128>, 50);
+
+	Benchmarks::Registrar querySmall("navigation_field_query_64x32", &field_query<64, 32>, 100, AgentCount);
+	Benchmarks::Registrar queryMedium("navigation_field_query_256x64", &field_query<256, 64>, 100, AgentCount);
+	Benchmarks::Registrar queryLarge("navigation_field_query_1024x128", &field_query<1024, 128>, 100, AgentCount);
+}
@@ -0,0 +1,64 @@
+#include <raylib.h>
+
+#include "Benchmarks.hpp"
+#include "../effects/ParticleEmitter.hpp"
+
+namespace
+{
+	constexpr int ParticleCount = 131072;
+
+	ParticleEmitter &get_full_emitter()
+	{
+		// particles never die during the benchmark so every update touches all of them
+		static ParticleEmitter emitter = []
+		{
+			ParticleEmitterConfig config;
+			config.capacity = ParticleCount;
+			config.minLifetime = 1e6f;
+			config.maxLifetime = 1e6f;
+			config.gravity = 100.0f;
+			config.drag = 0.5f;
+
+			ParticleEmitter fullEmitter(config);
+			fullEmitter.emit({200, 200}, ParticleCount);
+			return fullEmitter;
+		}();
+
+		return emitter;
+	}
+
+	void particles_update_scalar(int iterations)
+	{
+		auto &emitter = get_full_emitter();
+		for (int i = 0; i < iterations; i++)
+		{
+			emitter.update_scalar(1.0f / 60.0f);
+		}
+		Benchmarks::do_not_optimize(emitter.alive_count());
+	}
+
+	void particles_update_simd(int iterations)
+	{
+		auto &emitter = get_full_emitter();
+		for (int i = 0; i < iterations; i++)
+		{
+			emitter.update_simd(1.0f / 60.0f);
+		}
+		Benchmarks::do_not_optimize(emitter.alive_count());
+	}
+
+	void particles_draw(int iterations)
+	{
+		auto &emitter = get_full_emitter();
+		for (int i = 0; i < iterations; i++)
+		{
+			BeginDrawing();
+			emitter.draw();
+			EndDrawing();
+		}
+	}
+
+	Benchmarks::Registrar scalarUpdate("particles_update_scalar", &particles_update_scalar, 200, ParticleCount);
+	Benchmarks::Registrar simdUpdate("particles_update_simd", &particles_update_simd, 200, ParticleCount);
+	Benchmarks::Registrar drawBatch("particles_draw_batched", &particles_draw, 20, ParticleCount);
+}
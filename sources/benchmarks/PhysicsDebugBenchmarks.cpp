@@ -0,0 +1,57 @@
+#include <memory>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/Project.hpp>
+
+#include <utils/AssetRegistry.hpp>
+
+#include "Benchmarks.hpp"
+#include "../physics/LevelColliders.hpp"
+#include "../rendering/PhysicsDebugRenderer.hpp"
+
+namespace
+{
+	struct PhysicsDebugFixture
+	{
+		ldtk::Project project;
+		std::unique_ptr<b2World> world;
+		PhysicsDebugRenderer renderer;
+
+		PhysicsDebugFixture()
+		{
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+			world = std::make_unique<b2World>(b2Vec2(0.0f, 60.0f));
+			LevelColliders::create(&project.getWorld().getLevel(0), world.get(), {0, 0}, false);
+
+			renderer.set_enabled(true);
+		}
+	};
+
+	// the level's static colliders are only turned into lines once
+	void physics_debug_draw_cached(PhysicsDebugFixture &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			BeginDrawing();
+			fixture.renderer.draw(fixture.world.get());
+			EndDrawing();
+		}
+	}
+
+	// what every frame would cost if static geometry was traversed again
+	void physics_debug_draw_uncached(PhysicsDebugFixture &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			fixture.renderer.invalidate();
+
+			BeginDrawing();
+			fixture.renderer.draw(fixture.world.get());
+			EndDrawing();
+		}
+	}
+
+	Benchmarks::Registrar cached("physics_debug_draw_cached", &physics_debug_draw_cached, 200);
+	Benchmarks::Registrar uncached("physics_debug_draw_uncached", &physics_debug_draw_uncached, 200);
+}
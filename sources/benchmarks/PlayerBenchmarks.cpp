@@ -0,0 +1,39 @@
+#include <LDtkLoader/Project.hpp>
+
+#include <Constants.hpp>
+#include <utils/AssetRegistry.hpp>
+
+#include "Benchmarks.hpp"
+#include "../world/BatchRunner.hpp"
+#include "../world/Simulation.hpp"
+
+namespace
+{
+	// one player running and jumping around the first level, the warm-up
+	// tick leaves it mid-level so every timed iteration is a plain tick
+	struct PlayerFixture
+	{
+		ldtk::Project project;
+		Simulation simulation;
+
+		PlayerFixture()
+		{
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+			simulation.load_level(&project.getWorld().getLevel(0));
+		}
+	};
+
+	// a tick of the player's movement logic together with the physics step it relies on
+	void player_movement_tick(PlayerFixture &fixture, int iterations)
+	{
+		auto &simulation = fixture.simulation;
+
+		for (int i = 0; i < iterations; i++)
+		{
+			simulation.step(BatchRunner::random_input(0, simulation.get_tick_count()));
+		}
+		Benchmarks::do_not_optimize(simulation.get_player()->get_position());
+	}
+
+	Benchmarks::Registrar movementTick("player_movement_tick", &player_movement_tick, 10000);
+}
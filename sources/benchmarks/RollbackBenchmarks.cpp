@@ -0,0 +1,74 @@
+#include <memory>
+
+#include <LDtkLoader/Project.hpp>
+
+#include <Constants.hpp>
+#include <utils/AssetRegistry.hpp>
+
+#include "Benchmarks.hpp"
+#include "../net/LoopbackNetwork.hpp"
+#include "../net/RollbackSession.hpp"
+#include "../world/BatchRunner.hpp"
+
+namespace
+{
+	// two peers on a perfect network, so nothing rolls back unless we ask for it
+	struct RollbackFixture
+	{
+		ldtk::Project project;
+		LoopbackNetwork network{{.latencyTicks = 0, .jitterTicks = 0, .lossRate = 0.0f}};
+		std::unique_ptr<RollbackSession> sessions[2];
+		int tick = 0;
+
+		RollbackFixture()
+		{
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+			const auto *level = &project.getWorld().getLevel(0);
+
+			for (int player = 0; player < 2; player++)
+			{
+				sessions[player] = std::make_unique<RollbackSession>(level, network.get_endpoint(player), RollbackSession::Config{.localPlayer = player});
+			}
+
+			// fill the history so there is always a full window to roll back
+			for (int i = 0; i < NetworkConstants::MaxRollback * 2; i++)
+			{
+				advance();
+			}
+		}
+
+		void advance()
+		{
+			for (int player = 0; player < 2; player++)
+			{
+				sessions[player]->advance(BatchRunner::random_input(player, tick));
+			}
+			network.advance();
+			tick++;
+		}
+	};
+
+	// one tick of both peers without any rollback, per peer
+	void session_tick(RollbackFixture &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			fixture.advance();
+		}
+		Benchmarks::do_not_optimize(fixture.sessions[0]->get_current_tick());
+	}
+
+	// restoring and re-simulating the whole rollback window, the worst case
+	// frame costs this plus one session tick
+	void resimulate_window(RollbackFixture &fixture, int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			fixture.sessions[0]->force_rollback(NetworkConstants::MaxRollback);
+		}
+		Benchmarks::do_not_optimize(fixture.sessions[0]->get_metrics().resimulatedTicks);
+	}
+
+	Benchmarks::Registrar sessionTick("rollback_session_tick", &session_tick, 1000, 2);
+	Benchmarks::Registrar resimulateWindow("rollback_resimulate_max_window", &resimulate_window, 1000, NetworkConstants::MaxRollback);
+}
@@ -0,0 +1,19 @@
+#include "Benchmarks.hpp"
+#include "../scenes/SceneManager.hpp"
+
+namespace
+{
+	// going from the title screen to the game and back, including the assets
+	// each scene loads and frees
+	void scene_switch(int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			SceneManager::set_current_screen(Scenes::GAME);
+			SceneManager::set_current_screen(Scenes::TITLE);
+		}
+		SceneManager::cleanup();
+	}
+
+	Benchmarks::Registrar sceneSwitch("scene_switch_title_game", &scene_switch, 10, 2);
+}
@@ -0,0 +1,51 @@
+#include <LDtkLoader/Project.hpp>
+
+#include <Constants.hpp>
+#include <utils/AssetRegistry.hpp>
+
+#include "Benchmarks.hpp"
+#include "../world/BatchRunner.hpp"
+
+namespace
+{
+	// enough instances that every thread gets several, even on big machines
+	constexpr int InstanceCount = 64;
+	constexpr int TicksPerInstance = 600;
+
+	struct SimulationFixture
+	{
+		ldtk::Project project;
+
+		SimulationFixture()
+		{
+			project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+		}
+	};
+
+	// ticks per second should scale with the thread count until we run out of cores,
+	// `ThreadCount` 0 uses every hardware thread
+	template <int ThreadCount>
+	void batch(SimulationFixture &fixture, int iterations)
+	{
+		BatchRunner::Options options{
+			.instanceCount = InstanceCount,
+			.ticks = TicksPerInstance,
+			.threadCount = ThreadCount,
+		};
+
+		int respawns = 0;
+		for (int i = 0; i < iterations; i++)
+		{
+			for (auto &&result : BatchRunner::run(&fixture.project.getWorld(), options, &BatchRunner::random_input))
+			{
+				respawns += result.respawns;
+			}
+		}
+		Benchmarks::do_not_optimize(respawns);
+	}
+
+	Benchmarks::Registrar batch1("simulation_batch_1_thread", &batch<1>, 3, InstanceCount * TicksPerInstance);
+	Benchmarks::Registrar batch2("simulation_batch_2_threads", &batch<2>, 3, InstanceCount * TicksPerInstance);
+	Benchmarks::Registrar batch4("simulation_batch_4_threads", &batch<4>, 3, InstanceCount * TicksPerInstance);
+	Benchmarks::Registrar batchAll("simulation_batch_all_threads", &batch<0>, 3, InstanceCount * TicksPerInstance);
+}
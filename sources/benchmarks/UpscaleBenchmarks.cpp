@@ -0,0 +1,76 @@
+#include <cstdio>
+
+#include <raylib.h>
+
+#include "Benchmarks.hpp"
+#include "../rendering/UpscalePipeline.hpp"
+
+namespace
+{
+	// draws an empty game frame through the pipeline, so only the upscale,
+	// post-process and present passes are measured. Every benchmark gets its own
+	// pipeline as fixture, its shaders are compiled during the warm-up run.
+	void present_frames(UpscalePipeline &pipeline, const UpscaleConfig &config, int iterations)
+	{
+		pipeline.set_config(config);
+
+		for (int i = 0; i < iterations; i++)
+		{
+			pipeline.update_layout();
+			pipeline.begin_game();
+			ClearBackground(RAYWHITE);
+			pipeline.end_game();
+
+			BeginDrawing();
+			pipeline.present();
+			EndDrawing();
+		}
+
+		// per pass breakdown of the timed run, not of the warm-up
+		if (iterations > 1)
+		{
+			for (auto &&timing : pipeline.get_pass_timings())
+			{
+				std::printf("    %-36s %.3f ms\n", timing.name, timing.averageMs);
+			}
+		}
+	}
+
+	void upscale_integer(UpscalePipeline &pipeline, int iterations)
+	{
+		present_frames(pipeline, {.scaleMode = ScaleMode::INTEGER}, iterations);
+	}
+
+	void upscale_letterbox_bilinear(UpscalePipeline &pipeline, int iterations)
+	{
+		present_frames(pipeline, {.scaleMode = ScaleMode::LETTERBOX, .filter = TEXTURE_FILTER_BILINEAR}, iterations);
+	}
+
+	void upscale_crt(UpscalePipeline &pipeline, int iterations)
+	{
+		present_frames(pipeline, {.postEffects = {PostEffect::CRT}}, iterations);
+	}
+
+	void upscale_crt_bloom(UpscalePipeline &pipeline, int iterations)
+	{
+		present_frames(pipeline, {.postEffects = {PostEffect::CRT, PostEffect::BLOOM}}, iterations);
+	}
+
+	void upscale_crt_bloom_render_scale_4(UpscalePipeline &pipeline, int iterations)
+	{
+		present_frames(pipeline, {.renderScale = 4, .postEffects = {PostEffect::CRT, PostEffect::BLOOM}}, iterations);
+	}
+
+	// the lowest quality level's resolution
+	void upscale_integer_half_resolution(UpscalePipeline &pipeline, int iterations)
+	{
+		present_frames(pipeline, {.scaleMode = ScaleMode::INTEGER, .resolutionScale = 0.5f}, iterations);
+	}
+
+	Benchmarks::Registrar integer("upscale_integer", &upscale_integer, 200);
+	Benchmarks::Registrar letterbox("upscale_letterbox_bilinear", &upscale_letterbox_bilinear, 200);
+	Benchmarks::Registrar crt("upscale_crt", &upscale_crt, 200);
+	Benchmarks::Registrar crtBloom("upscale_crt_bloom", &upscale_crt_bloom, 200);
+	Benchmarks::Registrar halfResolution("upscale_integer_half_resolution", &upscale_integer_half_resolution, 200);
+	Benchmarks::Registrar crtBloomScale4("upscale_crt_bloom_render_scale_4", &upscale_crt_bloom_render_scale_4, 200);
+}
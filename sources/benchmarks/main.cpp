@@ -0,0 +1,48 @@
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+
+#include <raylib.h>
+#include <raygui.h>
+
+#include <Constants.hpp>
+
+#include "Benchmarks.hpp"
+#include "../rendering/UpscalePipeline.hpp"
+
+int main(int argc, char **argv)
+{
+	// `benchmarks [filter]` runs every benchmark whose name contains the filter,
+	// `--json <path>` also writes their results to a JSON file
+	std::string_view filter;
+	std::string_view jsonPath;
+	for (int i = 1; i < argc; i++)
+	{
+		auto arg = std::string_view(argv[i]);
+		if (arg == "--json" && i + 1 < argc)
+		{
+			jsonPath = argv[++i];
+		}
+		else if (!arg.starts_with("--"))
+		{
+			filter = arg;
+		}
+	}
+
+	// benchmarks can use raylib resources, so they run in a hidden window set
+	// up like the game's
+	SetConfigFlags(FLAG_WINDOW_HIDDEN);
+	InitWindow(
+		AppConstants::ScreenWidth,
+		AppConstants::ScreenHeight,
+		AppConstants::WindowTitle.data());
+
+	GuiLoadStyleDefault();
+	auto upscalePipeline = std::make_unique<UpscalePipeline>();
+
+	int exitCode = Benchmarks::run(filter, jsonPath);
+
+	upscalePipeline.reset();
+	CloseWindow();
+	return exitCode;
+}
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+#include <raylib.h>
+#include <rlgl.h>
+
+#include <utils/Simd.hpp>
+
+#include "ParticleEmitter.hpp"
+
+namespace
+{
+	// number of SoA streams stored in the emitter
+	constexpr int StreamCount = 10;
+
+	int round_up_to_simd_width(int value)
+	{
+		return ((value + Simd::Width - 1) / Simd::Width) * Simd::Width;
+	}
+}
+
+void ParticleEmitter::AlignedDelete::operator()(float *ptr) const
+{
+	::operator delete[](ptr, std::align_val_t(Simd::Alignment));
+}
+
+ParticleEmitter::ParticleEmitter(const ParticleEmitterConfig &config)
+	: config(config),
+	  capacity(round_up_to_simd_width(std::max(config.capacity, 1))),
+	  maxParticles(config.capacity)
+{
+	auto bytes = sizeof(float) * capacity * StreamCount;
+	storage.reset(static_cast<float *>(::operator new[](bytes, std::align_val_t(Simd::Alignment))));
+	std::fill_n(storage.get(), capacity * StreamCount, 0.0f);
+
+	// capacity is a multiple of the SIMD width, so every stream stays aligned
+	posX = storage.get();
+	posY = posX + capacity;
+	velX = posY + capacity;
+	velY = velX + capacity;
+	life = velY + capacity;
+	invLifetime = life + capacity;
+	colorR = invLifetime + capacity;
+	colorG = colorR + capacity;
+	colorB = colorG + capacity;
+	colorA = colorB + capacity;
+}
+
+float ParticleEmitter::random_range(float min, float max)
+{
+	// xorshift32, particles don't need anything better and this keeps
+	// emitters independent from raylib's global random state
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+
+	float t = (randomState & 0xFFFFFF) / float(0xFFFFFF);
+	return min + (max - min) * t;
+}
+
+void ParticleEmitter::emit(Vector2 position, int amount)
+{
+	amount = std::min(amount, maxParticles - count);
+
+	for (int i = 0; i < amount; i++)
+	{
+		int p = count++;
+
+		float angle = config.direction + random_range(-config.spread, config.spread);
+		float speed = random_range(config.minSpeed, config.maxSpeed);
+		float lifetime = random_range(config.minLifetime, config.maxLifetime);
+
+		posX[p] = position.x;
+		posY[p] = position.y;
+		velX[p] = std::cos(angle) * speed;
+		velY[p] = std::sin(angle) * speed;
+		life[p] = lifetime;
+		invLifetime[p] = 1.0f / lifetime;
+		colorR[p] = config.startColor.r;
+		colorG[p] = config.startColor.g;
+		colorB[p] = config.startColor.b;
+		colorA[p] = config.startColor.a;
+	}
+}
+
+void ParticleEmitter::update(float dt)
+{
+	update_simd(dt);
+}
+
+void ParticleEmitter::update_scalar(float dt)
+{
+	const float damping = std::max(1.0f - config.drag * dt, 0.0f);
+	const float gravityStep = config.gravity * dt;
+
+	const float endR = config.endColor.r, deltaR = float(config.startColor.r) - config.endColor.r;
+	const float endG = config.endColor.g, deltaG = float(config.startColor.g) - config.endColor.g;
+	const float endB = config.endColor.b, deltaB = float(config.startColor.b) - config.endColor.b;
+	const float endA = config.endColor.a, deltaA = float(config.startColor.a) - config.endColor.a;
+
+	for (int i = 0; i < count; i++)
+	{
+		velX[i] = velX[i] * damping;
+		velY[i] = (velY[i] + gravityStep) * damping;
+		posX[i] = velX[i] * dt + posX[i];
+		posY[i] = velY[i] * dt + posY[i];
+		life[i] = life[i] - dt;
+
+		// 1 when the particle is born, 0 when it dies
+		float t = std::max(life[i], 0.0f) * invLifetime[i];
+		colorR[i] = deltaR * t + endR;
+		colorG[i] = deltaG * t + endG;
+		colorB[i] = deltaB * t + endB;
+		colorA[i] = deltaA * t + endA;
+	}
+
+	remove_dead_particles();
+}
+
+void ParticleEmitter::update_simd(float dt)
+{
+	using namespace Simd;
+
+	const float4 dtV = set1(dt);
+	const float4 zero = set1(0.0f);
+	const float4 damping = set1(std::max(1.0f - config.drag * dt, 0.0f));
+	const float4 gravityStep = set1(config.gravity * dt);
+
+	const float4 endR = set1(config.endColor.r), deltaR = set1(float(config.startColor.r) - config.endColor.r);
+	const float4 endG = set1(config.endColor.g), deltaG = set1(float(config.startColor.g) - config.endColor.g);
+	const float4 endB = set1(config.endColor.b), deltaB = set1(float(config.startColor.b) - config.endColor.b);
+	const float4 endA = set1(config.endColor.a), deltaA = set1(float(config.startColor.a) - config.endColor.a);
+
+	// storage is padded to the SIMD width, so the tail can be processed as a
+	// full vector. Values past `count` are garbage that is never read.
+	const int vectorCount = round_up_to_simd_width(count);
+
+	for (int i = 0; i < vectorCount; i += Width)
+	{
+		float4 vx = mul(load(velX + i), damping);
+		float4 vy = mul(add(load(velY + i), gravityStep), damping);
+		store(velX + i, vx);
+		store(velY + i, vy);
+
+		store(posX + i, mul_add(vx, dtV, load(posX + i)));
+		store(posY + i, mul_add(vy, dtV, load(posY + i)));
+
+		float4 remaining = sub(load(life + i), dtV);
+		store(life + i, remaining);
+
+		float4 t = mul(max(remaining, zero), load(invLifetime + i));
+		store(colorR + i, mul_add(deltaR, t, endR));
+		store(colorG + i, mul_add(deltaG, t, endG));
+		store(colorB + i, mul_add(deltaB, t, endB));
+		store(colorA + i, mul_add(deltaA, t, endA));
+	}
+
+	remove_dead_particles();
+}
+
+void ParticleEmitter::remove_dead_particles()
+{
+	int i = 0;
+	while (i < count)
+	{
+		if (life[i] > 0.0f)
+		{
+			i++;
+			continue;
+		}
+
+		// swap the last live particle into this slot
+		int last = --count;
+		posX[i] = posX[last];
+		posY[i] = posY[last];
+		velX[i] = velX[last];
+		velY[i] = velY[last];
+		life[i] = life[last];
+		invLifetime[i] = invLifetime[last];
+		colorR[i] = colorR[last];
+		colorG[i] = colorG[last];
+		colorB[i] = colorB[last];
+		colorA[i] = colorA[last];
+	}
+}
+
+void ParticleEmitter::draw() const
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	const float halfSize = config.size / 2.0f;
+
+	// raylib's default texture is a single white texel, so this is one batch
+	// of flat coloured quads. rlgl flushes on its own if the batch fills up.
+	rlSetTexture(rlGetTextureIdDefault());
+	rlBegin(RL_QUADS);
+
+	for (int i = 0; i < count; i++)
+	{
+		rlColor4ub((unsigned char)colorR[i], (unsigned char)colorG[i], (unsigned char)colorB[i], (unsigned char)colorA[i]);
+
+		float left = posX[i] - halfSize;
+		float top = posY[i] - halfSize;
+		float right = posX[i] + halfSize;
+		float bottom = posY[i] + halfSize;
+
+		rlTexCoord2f(0.0f, 0.0f);
+		rlVertex2f(left, top);
+		rlTexCoord2f(0.0f, 1.0f);
+		rlVertex2f(left, bottom);
+		rlTexCoord2f(1.0f, 1.0f);
+		rlVertex2f(right, bottom);
+		rlTexCoord2f(1.0f, 0.0f);
+		rlVertex2f(right, top);
+	}
+
+	rlEnd();
+	rlSetTexture(0);
+}
+
+void ParticleEmitter::set_max_particles(int amount)
+{
+	maxParticles = std::clamp(amount, 0, capacity);
+}
+
+int ParticleEmitter::alive_count() const
+{
+	return count;
+}
+
+int ParticleEmitter::get_capacity() const
+{
+	return capacity;
+}
+
+void ParticleEmitter::clear()
+{
+	count = 0;
+}
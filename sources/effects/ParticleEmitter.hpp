@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <raylib.h>
+
+struct ParticleEmitterConfig
+{
+    // Maximum number of live particles, storage is allocated once up-front
+    int capacity = 256;
+
+    Color startColor = WHITE;
+    Color endColor = BLANK;
+
+    float minLifetime = 0.3f;
+    float maxLifetime = 0.6f;
+
+    float minSpeed = 20.0f;
+    float maxSpeed = 60.0f;
+
+    // Direction particles are emitted at and how much they spread around it, in radians
+    float direction = -PI / 2.0f;
+    float spread = PI / 4.0f;
+
+    // Acceleration on the y axis (pixels/s^2) and velocity damping per second
+    float gravity = 0.0f;
+    float drag = 0.0f;
+
+    float size = 2.0f;
+};
+
+/**
+ * Fixed capacity particle pool. Particles are stored as a structure of arrays
+ * so the update kernel can process Simd::Width particles at once. Dead
+ * particles are swapped with the last live one, so the live particles are
+ * always packed at the start of each array.
+ */
+class ParticleEmitter
+{
+private:
+    struct AlignedDelete
+    {
+        void operator()(float *ptr) const;
+    };
+
+    ParticleEmitterConfig config;
+
+    int capacity;
+    int count = 0;
+    int maxParticles;
+    uint32_t randomState = 0x9E3779B9u;
+
+    // one allocation holding every SoA stream, each `capacity` floats long
+    std::unique_ptr<float[], AlignedDelete> storage;
+
+    float *posX;
+    float *posY;
+    float *velX;
+    float *velY;
+    float *life;
+    float *invLifetime;
+    float *colorR;
+    float *colorG;
+    float *colorB;
+    float *colorA;
+
+    float random_range(float min, float max);
+    void remove_dead_particles();
+
+public:
+    explicit ParticleEmitter(const ParticleEmitterConfig &config);
+
+    void emit(Vector2 position, int amount);
+
+    // Runs the SIMD kernel, update_scalar is kept to compare against
+    void update(float dt);
+    void update_scalar(float dt);
+    void update_simd(float dt);
+
+    // Draws every live particle as a quad in a single batch
+    void draw() const;
+
+    // Lower the number of particles that may be alive, never above capacity
+    void set_max_particles(int amount);
+
+    int alive_count() const;
+    int get_capacity() const;
+    void clear();
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <raylib.h>
+
+#include "ParticleEmitter.hpp"
+
+// Emitter configurations for the effects used by the game. Colours are picked
+// to match the Pixel Adventure 1 palette.
+namespace ParticlePresets
+{
+    inline ParticleEmitterConfig JumpDust()
+    {
+        return {
+            .capacity = 64,
+            .startColor = {222, 222, 222, 220},
+            .endColor = {222, 222, 222, 0},
+            .minLifetime = 0.2f,
+            .maxLifetime = 0.4f,
+            .minSpeed = 10.0f,
+            .maxSpeed = 30.0f,
+            .direction = PI / 2.0f,
+            .spread = PI / 2.0f,
+            .gravity = -20.0f,
+            .drag = 4.0f,
+            .size = 2.0f,
+        };
+    }
+
+    inline ParticleEmitterConfig LandingImpact()
+    {
+        return {
+            .capacity = 64,
+            .startColor = {200, 180, 150, 255},
+            .endColor = {200, 180, 150, 0},
+            .minLifetime = 0.15f,
+            .maxLifetime = 0.35f,
+            .minSpeed = 30.0f,
+            .maxSpeed = 70.0f,
+            .direction = -PI / 2.0f,
+            .spread = PI / 2.5f,
+            .gravity = 200.0f,
+            .drag = 2.0f,
+            .size = 2.0f,
+        };
+    }
+
+    inline ParticleEmitterConfig FruitPickup()
+    {
+        return {
+            .capacity = 128,
+            .startColor = {255, 220, 80, 255},
+            .endColor = {255, 120, 40, 0},
+            .minLifetime = 0.3f,
+            .maxLifetime = 0.6f,
+            .minSpeed = 20.0f,
+            .maxSpeed = 60.0f,
+            .direction = -PI / 2.0f,
+            .spread = PI,
+            .gravity = 0.0f,
+            .drag = 3.0f,
+            .size = 2.0f,
+        };
+    }
+
+    inline ParticleEmitterConfig TrapHit()
+    {
+        return {
+            .capacity = 128,
+            .startColor = {230, 41, 55, 255},
+            .endColor = {120, 20, 30, 0},
+            .minLifetime = 0.2f,
+            .maxLifetime = 0.5f,
+            .minSpeed = 60.0f,
+            .maxSpeed = 120.0f,
+            .direction = -PI / 2.0f,
+            .spread = PI,
+            .gravity = 300.0f,
+            .drag = 1.0f,
+            .size = 3.0f,
+        };
+    }
+}
@@ -0,0 +1,114 @@
+#include <array>
+#include <optional>
+#include <string>
+
+#include <raylib.h>
+#include <LDtkLoader/Entity.hpp>
+
+#include <Constants.hpp>
+#include <utils/DebugUtils.hpp>
+
+#include "ActorDefinition.hpp"
+
+namespace
+{
+	constexpr std::array<ActorPreset, ActorKindCount> Presets = {{
+		{"Spikes", AssetId::SPIKES_SPRITE, 16, 16, 1, true, false, ActorMovement::NONE, 0.0f},
+		{"Saw", AssetId::SAW_SPRITE, 38, 38, 8, true, false, ActorMovement::NONE, 60.0f},
+		{"MovingPlatform", AssetId::PLATFORM_SPRITE, 32, 8, 1, false, true, ActorMovement::NONE, 40.0f},
+		{"Patrol", AssetId::PATROL_SPRITE, 32, 32, 12, true, false, ActorMovement::PATROL, 30.0f},
+	}};
+}
+
+const ActorPreset &get_actor_preset(ActorKind kind)
+{
+	return Presets[(size_t)kind];
+}
+
+ActorDefinition ActorDefinition::from_kind(ActorKind kind, Rectangle bounds)
+{
+	const auto &preset = get_actor_preset(kind);
+	return {
+		.kind = kind,
+		.bounds = bounds,
+		.hazard = preset.hazard,
+		.solid = preset.solid,
+		.movement = preset.movement,
+		.speed = preset.speed,
+		.path = {{bounds.x, bounds.y}},
+	};
+}
+
+std::optional<ActorDefinition> ActorDefinition::from_entity(const ldtk::Entity &entity, Vector2 levelOffset)
+{
+	const auto &name = entity.getName();
+
+	std::optional<ActorKind> kind;
+	for (int i = 0; i < ActorKindCount; i++)
+	{
+		if (name == Presets[i].entityName)
+		{
+			kind = (ActorKind)i;
+			break;
+		}
+	}
+
+	if (!kind)
+	{
+		return std::nullopt;
+	}
+
+	Rectangle bounds = {
+		levelOffset.x + entity.getPosition().x,
+		levelOffset.y + entity.getPosition().y,
+		(float)entity.getSize().x,
+		(float)entity.getSize().y,
+	};
+	auto definition = from_kind(*kind, bounds);
+
+	if (entity.hasField("speed") && !entity.getField<float>("speed").is_null())
+	{
+		definition.speed = entity.getField<float>("speed").value();
+	}
+
+	if (entity.hasField("loop") && !entity.getField<bool>("loop").is_null())
+	{
+		definition.loop = entity.getField<bool>("loop").value();
+	}
+
+	if (entity.hasField("period") && !entity.getField<float>("period").is_null())
+	{
+		definition.period = entity.getField<float>("period").value();
+	}
+
+	if (entity.hasField("chase") && !entity.getField<bool>("chase").is_null() && entity.getField<bool>("chase").value())
+	{
+		definition.movement = ActorMovement::CHASE;
+	}
+
+	if (entity.hasField("path"))
+	{
+		for (auto &&point : entity.getArrayField<ldtk::IntPoint>("path"))
+		{
+			if (point.is_null())
+			{
+				continue;
+			}
+
+			// waypoints are cells, the actor is centered on them like LDtk draws it
+			const float cellSize = GameConstants::CellSize;
+			definition.path.push_back({
+				levelOffset.x + point.value().x * cellSize + (cellSize - bounds.width) / 2,
+				levelOffset.y + point.value().y * cellSize + (cellSize - bounds.height) / 2,
+			});
+		}
+
+		if (definition.path.size() > 1 && definition.movement == ActorMovement::NONE)
+		{
+			definition.movement = ActorMovement::PATH;
+		}
+	}
+
+	DebugUtils::println("Actor {} with {} waypoints", name, definition.path.size());
+	return definition;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <raylib.h>
+#include <LDtkLoader/Entity.hpp>
+
+#include <utils/AssetRegistry.hpp>
+
+enum class ActorKind
+{
+    SPIKES,
+    SAW,
+    MOVING_PLATFORM,
+    PATROL,
+};
+
+constexpr int ActorKindCount = 4;
+
+enum class ActorMovement
+{
+    NONE,
+    // Follows the waypoints of its path
+    PATH,
+    // Walks left and right, turning around at walls and ledges
+    PATROL,
+    // Walks, jumps and falls along the flow field towards the player
+    CHASE,
+};
+
+// Defaults of every actor of a kind, see ActorDefinition
+struct ActorPreset
+{
+    // Name of the LDtk entity that spawns this kind
+    const char *entityName;
+
+    // Horizontal strip of equally sized animation frames
+    AssetId sprite;
+    int frameWidth;
+    int frameHeight;
+    int frameCount;
+
+    // Touching a hazard sends the player back to the spawn point
+    bool hazard;
+    // Solid actors get a kinematic body the player can stand on
+    bool solid;
+
+    ActorMovement movement;
+    float speed;
+};
+
+/**
+ * How one actor (trap, platform, simple enemy) behaves. The LDtk entity's name
+ * picks a preset and these optional fields of the entity override it:
+ *
+ *   speed  (Float)        pixels per second along the path or while patrolling
+ *   path   (Array<Point>) waypoints, in cells. The entity's own position is the
+ *                         first waypoint, a path makes the actor move along it
+ *   loop   (Bool)         go back to the first waypoint after the last one
+ *                         instead of walking the path backwards
+ *   period (Float)        seconds between switching on and off, 0 to stay on
+ *   chase  (Bool)         hunt the player down instead of patrolling
+ */
+struct ActorDefinition
+{
+    ActorKind kind;
+
+    // where the actor starts, in world pixels
+    Rectangle bounds;
+
+    bool hazard;
+    bool solid;
+    ActorMovement movement;
+    float speed;
+
+    // top-left corners in world pixels, the first one is the start position
+    std::vector<Vector2> path;
+    bool loop = false;
+
+    float period = 0;
+
+    // The preset of `kind` placed at `bounds`
+    static ActorDefinition from_kind(ActorKind kind, Rectangle bounds);
+
+    // Empty for entities that aren't actors (Player, Portal, ...)
+    static std::optional<ActorDefinition> from_entity(const ldtk::Entity &entity, Vector2 levelOffset = {0, 0});
+};
+
+const ActorPreset &get_actor_preset(ActorKind kind);
@@ -0,0 +1,622 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <raylib.h>
+#include <raymath.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+#include <utils/CookedTexture.hpp>
+#include <utils/DebugUtils.hpp>
+
+#include "ActorSystem.hpp"
+#include "../../physics/PhysicsTypes.hpp"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// how close (in pixels) an actor has to get to a waypoint to reach it
+	constexpr float WaypointTolerance = 0.5f;
+
+	// hazards are a bit smaller than their sprite so grazing them is forgiven
+	constexpr float HazardInset = 2.0f;
+
+	constexpr float AnimationFps = 20.0f;
+
+	Vector2 get_center(Rectangle rect)
+	{
+		return {rect.x + rect.width / 2, rect.y + rect.height / 2};
+	}
+}
+
+ActorSystem::ActorSystem(float tickBudgetMs) : tickBudgetMs(tickBudgetMs)
+{
+}
+
+ActorSystem::~ActorSystem()
+{
+	for (auto &&sprite : sprites)
+	{
+		if (sprite.id != 0)
+		{
+			UnloadTexture(sprite);
+		}
+	}
+}
+
+void ActorSystem::load_level(const ldtk::Level *level, b2World *world, const CollisionGrid *grid, Vector2 levelOffset)
+{
+	clear();
+	set_world(world, grid);
+	add_level(level, grid, levelOffset);
+}
+
+void ActorSystem::add_level(const ldtk::Level *level, const CollisionGrid *grid, Vector2 levelOffset)
+{
+	for (auto &&entity : level->getLayer("Entities").allEntities())
+	{
+		if (auto definition = ActorDefinition::from_entity(entity, levelOffset))
+		{
+			add(*definition, level, grid);
+		}
+	}
+}
+
+void ActorSystem::remove_level(const ldtk::Level *level)
+{
+	std::erase_if(actors, [&](const Actor &actor)
+				  {
+					  if (actor.level != level)
+					  {
+						  return false;
+					  }
+
+					  if (actor.body != nullptr)
+					  {
+						  world->DestroyBody(actor.body);
+					  }
+					  return true;
+				  });
+
+	// the cursors may be past the end now, every actor is due soon anyway
+	nearCursor = 0;
+	farCursor = 0;
+	metrics.actorCount = (int)actors.size();
+}
+
+void ActorSystem::set_world(b2World *world, const CollisionGrid *grid)
+{
+	this->world = world;
+	this->grid = grid;
+}
+
+void ActorSystem::set_flow_field(const FlowField *field)
+{
+	flowField = field;
+}
+
+void ActorSystem::add(const ActorDefinition &definition)
+{
+	add(definition, nullptr, grid);
+}
+
+void ActorSystem::add(const ActorDefinition &definition, const ldtk::Level *level, const CollisionGrid *grid)
+{
+	Actor actor{
+		.definition = definition,
+		.position = {definition.bounds.x, definition.bounds.y},
+		.lastUpdate = time,
+		.level = level,
+		.grid = grid,
+	};
+
+	if (definition.solid && world != nullptr)
+	{
+		auto center = get_center(definition.bounds);
+
+		b2BodyDef bodyDef;
+		bodyDef.type = b2_kinematicBody;
+		bodyDef.userData.pointer = (uintptr_t)PhysicsTypes::SolidBlock.data();
+		bodyDef.position.Set(center.x / GameConstants::PhysicsWorldScale, center.y / GameConstants::PhysicsWorldScale);
+		actor.body = world->CreateBody(&bodyDef);
+
+		b2PolygonShape box;
+		box.SetAsBox(definition.bounds.width / 2 / GameConstants::PhysicsWorldScale,
+					 definition.bounds.height / 2 / GameConstants::PhysicsWorldScale);
+		actor.body->CreateFixture(&box, 0.0f);
+	}
+
+	if (definition.movement == ActorMovement::PATH)
+	{
+		head_to_next_waypoint(actor);
+		if (actor.body != nullptr)
+		{
+			actor.body->SetLinearVelocity({actor.velocity.x / GameConstants::PhysicsWorldScale,
+										   actor.velocity.y / GameConstants::PhysicsWorldScale});
+		}
+	}
+	else if (definition.movement == ActorMovement::PATROL)
+	{
+		actor.velocity = {definition.speed, 0};
+	}
+
+	actors.push_back(actor);
+	metrics.actorCount = (int)actors.size();
+}
+
+void ActorSystem::clear()
+{
+	// bodies are destroyed with their world
+	actors.clear();
+	nearCursor = 0;
+	farCursor = 0;
+	time = 0;
+	metrics = {};
+}
+
+void ActorSystem::update(float dt, Vector2 focus, std::span<Player *const> players)
+{
+	auto start = Clock::now();
+	auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(tickBudgetMs));
+
+	time += dt;
+	metrics.updated = 0;
+	metrics.deferred = 0;
+	metrics.maxLag = 0;
+
+	const size_t count = actors.size();
+	bool overBudget = false;
+
+	// nearby actors get the budget first, what's on screen shouldn't wait behind far away actors
+	for (bool nearPass : {true, false})
+	{
+		size_t &cursor = nearPass ? nearCursor : farCursor;
+		size_t nextCursor = cursor;
+		int passUpdates = 0;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			size_t index = (cursor + i) % count;
+			auto &actor = actors[index];
+
+			float interval = get_update_interval(actor, focus);
+			if ((interval == 0) != nearPass)
+			{
+				continue;
+			}
+
+			float elapsed = time - actor.lastUpdate;
+			if (elapsed <= 0 || elapsed < interval)
+			{
+				continue;
+			}
+
+			// at least one update per pass, so neither near nor far actors starve on a slow machine
+			if (passUpdates > 0 && Clock::now() > deadline)
+			{
+				overBudget = true;
+			}
+
+			if (overBudget && passUpdates > 0)
+			{
+				metrics.deferred++;
+				metrics.maxLag = std::max(metrics.maxLag, elapsed);
+				continue;
+			}
+
+			update_actor(actor, std::min(elapsed, ActorConstants::MaxCatchUp), players);
+			actor.lastUpdate = time;
+			metrics.updated++;
+			passUpdates++;
+			nextCursor = (index + 1) % count;
+		}
+
+		// the first actor that didn't fit is the first one tried next tick
+		cursor = nextCursor;
+	}
+
+	metrics.updateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+float ActorSystem::get_update_interval(const Actor &actor, Vector2 focus) const
+{
+	float distance = Vector2Distance(get_center(get_bounds(actor)), focus);
+
+	if (distance <= ActorConstants::NearDistance)
+	{
+		return 0;
+	}
+
+	return distance <= ActorConstants::FarDistance ? ActorConstants::MidUpdateInterval : ActorConstants::FarUpdateInterval;
+}
+
+Rectangle ActorSystem::get_bounds(const Actor &actor) const
+{
+	Vector2 position = actor.position;
+	if (actor.body != nullptr)
+	{
+		auto center = actor.body->GetPosition();
+		position.x = center.x * GameConstants::PhysicsWorldScale - actor.definition.bounds.width / 2;
+		position.y = center.y * GameConstants::PhysicsWorldScale - actor.definition.bounds.height / 2;
+	}
+
+	return {position.x, position.y, actor.definition.bounds.width, actor.definition.bounds.height};
+}
+
+void ActorSystem::update_actor(Actor &actor, float elapsed, std::span<Player *const> players)
+{
+	const auto &definition = actor.definition;
+
+	if (definition.period > 0)
+	{
+		actor.activeTimer += elapsed;
+		while (actor.activeTimer >= definition.period)
+		{
+			actor.activeTimer -= definition.period;
+			actor.active = !actor.active;
+		}
+	}
+
+	switch (definition.movement)
+	{
+	case ActorMovement::PATH:
+		if (actor.body != nullptr)
+		{
+			follow_path_with_body(actor);
+		}
+		else
+		{
+			follow_path(actor, elapsed);
+		}
+		break;
+	case ActorMovement::PATROL:
+		patrol(actor, elapsed);
+		break;
+	case ActorMovement::CHASE:
+		chase(actor, elapsed);
+		break;
+	case ActorMovement::NONE:
+		break;
+	}
+
+	if (!definition.hazard || !actor.active)
+	{
+		return;
+	}
+
+	auto bounds = get_bounds(actor);
+	Rectangle hurtBox = {bounds.x + HazardInset,
+						 bounds.y + HazardInset,
+						 bounds.width - HazardInset * 2,
+						 bounds.height - HazardInset * 2};
+
+	for (auto player : players)
+	{
+		if (CheckCollisionRecs(hurtBox, player->get_bounds()))
+		{
+			DebugUtils::println("Player was hit by a {}", get_actor_preset(definition.kind).entityName);
+			player->respawn();
+		}
+	}
+}
+
+void ActorSystem::follow_path(Actor &actor, float elapsed)
+{
+	const auto &path = actor.definition.path;
+	float remaining = actor.definition.speed * elapsed;
+
+	// a long catch-up step may pass several waypoints
+	while (remaining > 0)
+	{
+		Vector2 target = path[actor.waypoint];
+		float distance = Vector2Distance(actor.position, target);
+
+		if (distance > remaining)
+		{
+			actor.position = Vector2MoveTowards(actor.position, target, remaining);
+			break;
+		}
+
+		actor.position = target;
+		remaining -= distance;
+		head_to_next_waypoint(actor);
+
+		// standing still (a zero length path) would loop forever
+		if (Vector2Distance(actor.position, path[actor.waypoint]) < WaypointTolerance)
+		{
+			break;
+		}
+	}
+
+	set_velocity_towards_waypoint(actor);
+}
+
+void ActorSystem::follow_path_with_body(Actor &actor)
+{
+	// Box2D moves kinematic bodies on its own at their velocity, so the
+	// platform moves smoothly (and carries the player) no matter how often
+	// it is updated. Updates only turn it around at the waypoints.
+	auto bounds = get_bounds(actor);
+	actor.position = {bounds.x, bounds.y};
+
+	Vector2 target = actor.definition.path[actor.waypoint];
+	Vector2 toTarget = Vector2Subtract(target, actor.position);
+
+	bool reached = Vector2Length(toTarget) < WaypointTolerance || Vector2DotProduct(toTarget, actor.velocity) <= 0;
+	if (reached)
+	{
+		// snap to the waypoint, far away platforms may have overshot it a bit
+		actor.position = target;
+		auto center = get_center({target.x, target.y, bounds.width, bounds.height});
+		actor.body->SetTransform({center.x / GameConstants::PhysicsWorldScale, center.y / GameConstants::PhysicsWorldScale}, 0);
+		head_to_next_waypoint(actor);
+	}
+
+	actor.body->SetLinearVelocity({actor.velocity.x / GameConstants::PhysicsWorldScale,
+								   actor.velocity.y / GameConstants::PhysicsWorldScale});
+}
+
+void ActorSystem::patrol(Actor &actor, float elapsed)
+{
+	// without a grid there are neither walls nor ledges to turn at
+	if (actor.grid == nullptr)
+	{
+		actor.velocity = {};
+		return;
+	}
+
+	float dx = actor.velocity.x * elapsed;
+	Rectangle bounds = get_bounds(actor);
+
+	auto sweep = actor.grid->sweep(bounds, {dx, 0});
+	actor.position = {sweep.rect.x, sweep.rect.y};
+
+	// turn around at walls and before walking off a ledge
+	float leadingEdge = dx > 0 ? sweep.rect.x + sweep.rect.width + 1 : sweep.rect.x - 1;
+	bool groundAhead = actor.grid->is_solid_at({leadingEdge, sweep.rect.y + sweep.rect.height + 1});
+
+	if (sweep.hitX || !groundAhead)
+	{
+		actor.velocity.x = -actor.velocity.x;
+	}
+}
+
+void ActorSystem::chase(Actor &actor, float elapsed)
+{
+	actor.velocity = {};
+	if (flowField == nullptr)
+	{
+		return;
+	}
+
+	const float width = actor.definition.bounds.width;
+	const float height = actor.definition.bounds.height;
+	auto to_actor_position = [&](Vector2 feet)
+	{
+		return Vector2{feet.x - width / 2, feet.y - height};
+	};
+
+	// the flow field is only asked at nodes, so an actor finishes a jump it
+	// started even if the field changed in the meantime
+	if (actor.chaseNode < 0)
+	{
+		auto step = flowField->get_step({actor.position.x + width / 2, actor.position.y + height - 1});
+		if (step.node < 0)
+		{
+			return;
+		}
+
+		actor.chaseNode = step.node;
+		actor.chaseTarget = to_actor_position(step.position);
+	}
+
+	// a long catch-up step may pass several nodes
+	float remaining = actor.definition.speed * elapsed;
+	while (remaining > 0)
+	{
+		float distance = Vector2Distance(actor.position, actor.chaseTarget);
+		if (distance > remaining)
+		{
+			actor.position = Vector2MoveTowards(actor.position, actor.chaseTarget, remaining);
+			break;
+		}
+
+		actor.position = actor.chaseTarget;
+		remaining -= distance;
+
+		// the target node leads to itself, and nodes the field can't reach lead nowhere
+		auto step = flowField->get_step_from(actor.chaseNode);
+		if (step.node < 0 || step.node == actor.chaseNode)
+		{
+			actor.chaseNode = -1;
+			return;
+		}
+
+		actor.chaseNode = step.node;
+		actor.chaseTarget = to_actor_position(step.position);
+	}
+
+	Vector2 toTarget = Vector2Subtract(actor.chaseTarget, actor.position);
+	float distance = Vector2Length(toTarget);
+	actor.velocity = distance > 0 ? Vector2Scale(toTarget, actor.definition.speed / distance) : Vector2{0, 0};
+}
+
+void ActorSystem::head_to_next_waypoint(Actor &actor)
+{
+	const auto &path = actor.definition.path;
+	if (path.size() < 2)
+	{
+		actor.waypoint = 0;
+		actor.velocity = {};
+		return;
+	}
+
+	if (actor.definition.loop)
+	{
+		actor.waypoint = (actor.waypoint + 1) % path.size();
+	}
+	else
+	{
+		// walk the path back and forth
+		if ((actor.waypoint == path.size() - 1 && actor.pathDirection > 0) || (actor.waypoint == 0 && actor.pathDirection < 0))
+		{
+			actor.pathDirection = -actor.pathDirection;
+		}
+		actor.waypoint += actor.pathDirection;
+	}
+
+	set_velocity_towards_waypoint(actor);
+}
+
+void ActorSystem::set_velocity_towards_waypoint(Actor &actor)
+{
+	Vector2 toTarget = Vector2Subtract(actor.definition.path[actor.waypoint], actor.position);
+	float distance = Vector2Length(toTarget);
+
+	actor.velocity = distance > 0 ? Vector2Scale(toTarget, actor.definition.speed / distance) : Vector2{0, 0};
+}
+
+void ActorSystem::load_sprites()
+{
+	for (int i = 0; i < ActorKindCount; i++)
+	{
+		if (sprites[i].id == 0)
+		{
+			sprites[i] = CookedTexture::load_asset_texture(get_actor_preset((ActorKind)i).sprite);
+		}
+	}
+}
+
+void ActorSystem::draw() const
+{
+	const int animationFrame = (int)(time * AnimationFps);
+
+	for (auto &&actor : actors)
+	{
+		auto bounds = get_bounds(actor);
+
+		// actors that aren't updated every tick are drawn where they would be by now
+		if (actor.body == nullptr)
+		{
+			float sinceUpdate = time - actor.lastUpdate;
+			bounds.x += actor.velocity.x * sinceUpdate;
+			bounds.y += actor.velocity.y * sinceUpdate;
+		}
+
+		const auto &preset = get_actor_preset(actor.definition.kind);
+		const auto &sprite = sprites[(size_t)actor.definition.kind];
+		Color tint = actor.active ? WHITE : Fade(WHITE, 0.3f);
+
+		if (sprite.id == 0)
+		{
+			// the sprite isn't loaded (or wasn't found), the actor still needs to be visible
+			DrawRectangleRec(bounds, Fade(actor.definition.hazard ? RED : DARKGRAY, actor.active ? 0.8f : 0.3f));
+			continue;
+		}
+
+		Rectangle source = {
+			float((animationFrame % preset.frameCount) * preset.frameWidth),
+			0,
+			float(preset.frameWidth),
+			float(preset.frameHeight),
+		};
+
+		// walking sprites face where they walk
+		bool walks = actor.definition.movement == ActorMovement::PATROL || actor.definition.movement == ActorMovement::CHASE;
+		if (walks && actor.velocity.x < 0)
+		{
+			source.width = -source.width;
+		}
+
+		DrawTexturePro(sprite, source, bounds, {0, 0}, 0, tint);
+	}
+}
+
+void ActorSystem::add_to_hash(StateHash &hash) const
+{
+	hash.add(time);
+	hash.add(nearCursor);
+	hash.add(farCursor);
+
+	// bodies are hashed with the rest of the physics world
+	for (auto &&actor : actors)
+	{
+		hash.add(actor.position);
+		hash.add(actor.velocity);
+		hash.add(actor.waypoint);
+		hash.add(actor.pathDirection);
+		hash.add(actor.chaseNode);
+		hash.add(actor.chaseTarget);
+		hash.add(actor.active);
+		hash.add(actor.activeTimer);
+		hash.add(actor.lastUpdate);
+	}
+}
+
+void ActorSystem::save_state(State &state) const
+{
+	state.time = time;
+	state.nearCursor = nearCursor;
+	state.farCursor = farCursor;
+	state.actors.resize(actors.size());
+
+	for (size_t i = 0; i < actors.size(); i++)
+	{
+		const auto &actor = actors[i];
+		state.actors[i] = {
+			.position = actor.position,
+			.velocity = actor.velocity,
+			.waypoint = actor.waypoint,
+			.pathDirection = actor.pathDirection,
+			.chaseNode = actor.chaseNode,
+			.chaseTarget = actor.chaseTarget,
+			.active = actor.active,
+			.activeTimer = actor.activeTimer,
+			.lastUpdate = actor.lastUpdate,
+			.bodyPosition = actor.body != nullptr ? actor.body->GetPosition() : b2Vec2(0.0f, 0.0f),
+			.bodyVelocity = actor.body != nullptr ? actor.body->GetLinearVelocity() : b2Vec2(0.0f, 0.0f),
+		};
+	}
+}
+
+void ActorSystem::load_state(const State &state)
+{
+	time = state.time;
+	nearCursor = state.nearCursor;
+	farCursor = state.farCursor;
+
+	for (size_t i = 0; i < actors.size() && i < state.actors.size(); i++)
+	{
+		auto &actor = actors[i];
+		const auto &saved = state.actors[i];
+
+		actor.position = saved.position;
+		actor.velocity = saved.velocity;
+		actor.waypoint = saved.waypoint;
+		actor.pathDirection = saved.pathDirection;
+		actor.chaseNode = saved.chaseNode;
+		actor.chaseTarget = saved.chaseTarget;
+		actor.active = saved.active;
+		actor.activeTimer = saved.activeTimer;
+		actor.lastUpdate = saved.lastUpdate;
+
+		if (actor.body != nullptr)
+		{
+			actor.body->SetTransform(saved.bodyPosition, 0);
+			actor.body->SetLinearVelocity(saved.bodyVelocity);
+		}
+	}
+}
+
+const ActorSystem::Metrics &ActorSystem::get_metrics() const
+{
+	return metrics;
+}
+
+size_t ActorSystem::get_actor_count() const
+{
+	return actors.size();
+}
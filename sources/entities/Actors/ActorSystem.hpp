@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+#include <utils/StateHash.hpp>
+
+#include "ActorDefinition.hpp"
+#include "../Player/Player.hpp"
+#include "../../navigation/FlowField.hpp"
+#include "../../physics/CollisionGrid.hpp"
+
+/**
+ * Runs the traps, platforms and simple enemies of a level (see
+ * ActorDefinition) as part of a Simulation, once per tick. Actors close to
+ * the camera update every tick, further away they update less often and
+ * catch up on the time they missed.
+ *
+ * Updates are time-sliced: each tick only runs updates until its CPU budget
+ * is spent, nearby actors first, and remembers where it stopped so the
+ * actors that didn't fit go first on the next tick. Checking which actors
+ * are due is a distance test per actor, the cost that is bounded is the
+ * actual behaviour updates.
+ */
+class ActorSystem
+{
+public:
+    struct Metrics
+    {
+        int actorCount = 0;
+
+        // updates run during the last tick
+        int updated = 0;
+
+        // actors that were due during the last tick but didn't fit the budget
+        int deferred = 0;
+
+        // seconds since the most starved deferred actor was last updated
+        float maxLag = 0;
+
+        float updateMs = 0;
+    };
+
+    // What changes about an actor while playing, see save_state
+    struct ActorState
+    {
+        Vector2 position;
+        Vector2 velocity;
+        size_t waypoint;
+        int pathDirection;
+        int chaseNode;
+        Vector2 chaseTarget;
+        bool active;
+        float activeTimer;
+        float lastUpdate;
+
+        // zero for actors without a body
+        b2Vec2 bodyPosition;
+        b2Vec2 bodyVelocity;
+    };
+
+    struct State
+    {
+        float time = 0;
+        size_t nearCursor = 0;
+        size_t farCursor = 0;
+        std::vector<ActorState> actors;
+    };
+
+private:
+    struct Actor
+    {
+        ActorDefinition definition;
+
+        // top-left corner in world pixels, and its velocity in pixels per second
+        Vector2 position;
+        Vector2 velocity{};
+
+        // waypoint the actor is heading to and the direction it walks its path in
+        size_t waypoint = 0;
+        int pathDirection = 1;
+
+        // navigation node a chasing actor is heading to (-1 to ask the flow
+        // field) and where the actor's top-left corner is once there
+        int chaseNode = -1;
+        Vector2 chaseTarget{};
+
+        bool active = true;
+        float activeTimer = 0;
+
+        // value of `time` at the last update
+        float lastUpdate = 0;
+
+        // only for solid actors, owned by the physics world
+        b2Body *body = nullptr;
+
+        // level the actor was loaded from (null if it was added on its own)
+        // and what it walks on if it patrols, the grid of that level
+        const ldtk::Level *level = nullptr;
+        const CollisionGrid *grid = nullptr;
+    };
+
+    std::vector<Actor> actors;
+
+    b2World *world{};
+    const CollisionGrid *grid{};
+    const FlowField *flowField{};
+
+    float tickBudgetMs;
+
+    // seconds since the level was loaded
+    float time = 0;
+
+    // where the near and far passes continue on the next tick
+    size_t nearCursor = 0;
+    size_t farCursor = 0;
+
+    Metrics metrics;
+
+    std::array<Texture2D, ActorKindCount> sprites{};
+
+    float get_update_interval(const Actor &actor, Vector2 focus) const;
+    Rectangle get_bounds(const Actor &actor) const;
+
+    void update_actor(Actor &actor, float elapsed, std::span<Player *const> players);
+    void follow_path(Actor &actor, float elapsed);
+    void follow_path_with_body(Actor &actor);
+    void patrol(Actor &actor, float elapsed);
+    void chase(Actor &actor, float elapsed);
+
+    void head_to_next_waypoint(Actor &actor);
+    void set_velocity_towards_waypoint(Actor &actor);
+
+    void add(const ActorDefinition &definition, const ldtk::Level *level, const CollisionGrid *grid);
+
+public:
+    explicit ActorSystem(float tickBudgetMs = ActorConstants::TickBudgetMs);
+    ~ActorSystem();
+
+    ActorSystem(const ActorSystem &) = delete;
+    ActorSystem &operator=(const ActorSystem &) = delete;
+
+    // Replaces the actors with the ones in the level's `Entities` layer. Solid
+    // actors get a body in `world`, bodies of the previous actors are expected
+    // to have gone away with their world. `grid` is used by patrolling actors.
+    void load_level(const ldtk::Level *level, b2World *world, const CollisionGrid *grid, Vector2 levelOffset = {0, 0});
+
+    // Adds the actors in the level's `Entities` layer next to the ones already
+    // there, used when several levels share a world (see LevelStreamer).
+    // Patrolling actors of the level walk on `grid`.
+    void add_level(const ldtk::Level *level, const CollisionGrid *grid, Vector2 levelOffset);
+
+    // Removes the actors added with `level` and destroys their bodies
+    void remove_level(const ldtk::Level *level);
+
+    // Where actors added from now on get their bodies (if solid) and what
+    // patrolling actors walk on, either may be null. Patrolling actors
+    // without a grid stand still.
+    void set_world(b2World *world, const CollisionGrid *grid);
+
+    // What chasing actors follow, null makes them stand still
+    void set_flow_field(const FlowField *field);
+
+    void add(const ActorDefinition &definition);
+    void clear();
+
+    // Once per simulation tick. `focus` is the center of the camera,
+    // `players` are hurt by hazards.
+    void update(float dt, Vector2 focus, std::span<Player *const> players);
+
+    // Headless runs never draw, so sprites are only loaded when asked for
+    void load_sprites();
+    void draw() const;
+
+    // Adds everything about the actors that isn't stored in their bodies
+    void add_to_hash(StateHash &hash) const;
+
+    // `state` is reused to avoid allocating
+    void save_state(State &state) const;
+
+    // Only for a state saved from the same actors, e.g. after a rollback.
+    // Their bodies are moved back too.
+    void load_state(const State &state);
+
+    const Metrics &get_metrics() const;
+    size_t get_actor_count() const;
+};
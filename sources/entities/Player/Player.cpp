@@ -9,19 +9,33 @@
 #include <LDtkLoader/World.hpp>
 
 #include <Constants.hpp>
+#include <utils/CookedTexture.hpp>
 #include <utils/DebugUtils.hpp>
 
 #include "Player.hpp"
 #include "../../physics/PhysicsTypes.hpp"
-#include "../../scenes/GameScene/GameScene.hpp"
 #include "../../physics/RaycastUtils.hpp"
 
 using namespace std;
 
-Player::Player()
+namespace
+{
+	// half size of the player's box, in physics units
+	constexpr float BodyHalfWidth = 0.9f;
+	constexpr float BodyHalfHeight = 1.0f;
+}
+
+PlayerInput PlayerInput::from_keyboard()
 {
-	this->sprite = LoadTexture(AppConstants::GetAssetPath("dinoCharactersVersion1.1/sheets/DinoSprites - vita.png").c_str());
+	return {
+		.left = IsKeyDown(KEY_LEFT),
+		.right = IsKeyDown(KEY_RIGHT),
+		.jump = IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_SPACE),
+	};
+}
 
+Player::Player()
+{
 	auto make_player_frame_rect = [](float frame_num) -> Rectangle
 	{
 		return {
@@ -58,12 +72,31 @@ Player::Player()
 
 Player::~Player()
 {
-	UnloadTexture(this->sprite);
+	if (this->sprite.id != 0)
+	{
+		UnloadTexture(this->sprite);
+	}
+}
+
+void Player::load_sprite()
+{
+	if (this->sprite.id == 0)
+	{
+		this->sprite = CookedTexture::load_asset_texture(AssetId::PLAYER_SPRITE);
+	}
+}
+
+void Player::set_input(const PlayerInput &input)
+{
+	this->input = input;
 }
 
 void Player::update(float dt)
 {
+	// damping is applied per tick rather than scaled by `dt`, so the result
+	// doesn't depend on how long the frame took
 	const float horizontalDampeningFactor = 1;
+	const float horizontalDampeningPerTick = 1 - GameConstants::TickDuration * horizontalDampeningFactor;
 
 	animation_ticker -= dt;
 	if (animation_ticker <= 0)
@@ -73,9 +106,14 @@ void Player::update(float dt)
 	}
 
 	// dampen horizontal movement
-	set_velocity_x(body->GetLinearVelocity().x * (1 - dt * horizontalDampeningFactor));
+	set_velocity_x(body->GetLinearVelocity().x * horizontalDampeningPerTick);
+
+	jumped = false;
+	bool was_touching_floor = is_touching_floor;
 
 	check_if_on_floor();
+	landed = !was_touching_floor && is_touching_floor;
+
 	check_if_move();
 	check_if_jump();
 
@@ -87,7 +125,7 @@ void Player::draw()
 	auto spritePosX = (body->GetPosition().x * GameConstants::PhysicsWorldScale) - 12;
 	auto spritePosY = (body->GetPosition().y * GameConstants::PhysicsWorldScale) - 13;
 
-	auto current_anim_states = animation_map[anim_state];
+	const auto &current_anim_states = animation_map[anim_state];
 	auto current_anim_rect = current_anim_states[current_anim_frame % current_anim_states.size()];
 
 	if (!looking_right)
@@ -103,33 +141,137 @@ void Player::draw()
 				   WHITE);
 }
 
-void Player::init_for_level(const ldtk::Entity *entity, b2World *physicsWorld)
+void Player::init_for_level(const ldtk::Entity *entity, b2World *physicsWorld, Vector2 levelOffset)
 {
 	auto pos = entity->getPosition();
 
-	DebugUtils::println("Setting player position to x:{} and y:{}", pos.x, pos.y);
+	DebugUtils::println("Setting player position to x:{} and y:{}", pos.x + levelOffset.x, pos.y + levelOffset.y);
 
-	level_spawn_position = {(float)pos.x / GameConstants::PhysicsWorldScale,
-							(float)pos.y / GameConstants::PhysicsWorldScale};
+	level_spawn_position = {(pos.x + levelOffset.x) / GameConstants::PhysicsWorldScale,
+							(pos.y + levelOffset.y) / GameConstants::PhysicsWorldScale};
 
+	create_body(physicsWorld, level_spawn_position);
+}
+
+void Player::create_body(b2World *physicsWorld, b2Vec2 position)
+{
 	b2BodyDef bodyDef;
 	bodyDef.type = b2_dynamicBody;
 	bodyDef.fixedRotation = true;
-	bodyDef.position.Set(level_spawn_position.x, level_spawn_position.y);
+
+	// input moves it every tick anyway, and the sleep timer is state that
+	// Simulation::save_state doesn't keep
+	bodyDef.allowSleep = false;
+	bodyDef.position.Set(position.x, position.y);
 
 	this->body = physicsWorld->CreateBody(&bodyDef);
 
 	b2PolygonShape dynamicBox;
-	dynamicBox.SetAsBox(0.9, 1);
+	dynamicBox.SetAsBox(BodyHalfWidth, BodyHalfHeight);
 
 	b2FixtureDef fixtureDef;
 	fixtureDef.shape = &dynamicBox;
 	fixtureDef.density = 1.0f;
 	fixtureDef.friction = 10.0f;
 
+	fixtureDef.filter.groupIndex = collision_group;
+
 	body->CreateFixture(&fixtureDef);
 }
 
+void Player::recreate_body(b2World *physicsWorld)
+{
+	create_body(physicsWorld, level_spawn_position);
+}
+
+void Player::set_collision_group(int16 group)
+{
+	collision_group = group;
+}
+
+void Player::set_respawn_bounds(Rectangle bounds)
+{
+	respawn_bounds = bounds;
+}
+
+Vector2 Player::get_position() const
+{
+	return {body->GetPosition().x * GameConstants::PhysicsWorldScale,
+			body->GetPosition().y * GameConstants::PhysicsWorldScale};
+}
+
+Rectangle Player::get_bounds() const
+{
+	auto position = get_position();
+	const float halfWidth = BodyHalfWidth * GameConstants::PhysicsWorldScale;
+	const float halfHeight = BodyHalfHeight * GameConstants::PhysicsWorldScale;
+	return {position.x - halfWidth, position.y - halfHeight, halfWidth * 2, halfHeight * 2};
+}
+
+void Player::respawn()
+{
+	set_velocity_xy(0, 0);
+	body->SetTransform(level_spawn_position, 0);
+	respawn_count++;
+}
+
+bool Player::has_jumped() const
+{
+	return jumped;
+}
+
+bool Player::has_landed() const
+{
+	return landed;
+}
+
+int Player::get_respawn_count() const
+{
+	return respawn_count;
+}
+
+void Player::add_to_hash(StateHash &hash) const
+{
+	hash.add(is_touching_floor);
+	hash.add(looking_right);
+	hash.add(respawn_count);
+}
+
+Player::State Player::get_state() const
+{
+	return {
+		.position = body->GetPosition(),
+		.velocity = body->GetLinearVelocity(),
+		.spawnPosition = level_spawn_position,
+		.input = input,
+		.isTouchingFloor = is_touching_floor,
+		.lookingRight = looking_right,
+		.jumped = jumped,
+		.landed = landed,
+		.respawnCount = respawn_count,
+		.animationTicker = animation_ticker,
+		.currentAnimFrame = current_anim_frame,
+		.animState = anim_state,
+	};
+}
+
+void Player::set_state(const State &state)
+{
+	body->SetTransform(state.position, 0);
+	body->SetLinearVelocity(state.velocity);
+
+	level_spawn_position = state.spawnPosition;
+	input = state.input;
+	is_touching_floor = state.isTouchingFloor;
+	looking_right = state.lookingRight;
+	jumped = state.jumped;
+	landed = state.landed;
+	respawn_count = state.respawnCount;
+	animation_ticker = state.animationTicker;
+	current_anim_frame = state.currentAnimFrame;
+	anim_state = state.animState;
+}
+
 void Player::set_velocity_x(float vx)
 {
 	body->SetLinearVelocity({
@@ -170,7 +312,7 @@ void Player::check_if_on_floor()
 		target.y += 1.1;
 
 		is_touching_floor = RaycastCheckCollisionWithUserData(
-			GameScene::world.get(),
+			body->GetWorld(),
 			source,
 			target,
 			PhysicsTypes::SolidBlock);
@@ -198,7 +340,7 @@ bool Player::can_move_in_x_direction(bool moving_right)
 		target.x += (moving_right ? 1 : -1) * 1.1;
 
 		auto is_agains_wall = RaycastCheckCollisionWithUserData(
-			GameScene::world.get(),
+			body->GetWorld(),
 			source,
 			target,
 			PhysicsTypes::SolidBlock);
@@ -214,9 +356,10 @@ bool Player::can_move_in_x_direction(bool moving_right)
 
 void Player::check_if_jump()
 {
-	if (is_touching_floor && (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_SPACE)))
+	if (is_touching_floor && input.jump)
 	{
 		set_velocity_y(-25);
+		jumped = true;
 	}
 
 	if (abs(body->GetLinearVelocity().x) > 0)
@@ -251,13 +394,13 @@ void Player::check_if_jump()
 void Player::check_if_move()
 {
 	const auto effective_speed = 15.0f;
-	if (IsKeyDown(KEY_LEFT) && can_move_in_x_direction(false))
+	if (input.left && can_move_in_x_direction(false))
 	{
 		looking_right = false;
 		set_velocity_x(-effective_speed);
 	}
 
-	if (IsKeyDown(KEY_RIGHT) && can_move_in_x_direction(true))
+	if (input.right && can_move_in_x_direction(true))
 	{
 		looking_right = true;
 		set_velocity_x(effective_speed);
@@ -266,13 +409,8 @@ void Player::check_if_move()
 
 void Player::check_if_should_respawn()
 {
-	auto body_pos = body->GetPosition();
-	auto is_out_of_x = body_pos.x < 0 || body_pos.x * GameConstants::PhysicsWorldScale > GameConstants::WorldWidth;
-	auto is_out_of_y = body_pos.y < 0 || body_pos.y * GameConstants::PhysicsWorldScale > GameConstants::WorldHeight;
-
-	if (is_out_of_x || is_out_of_y)
+	if (!CheckCollisionPointRec(get_position(), respawn_bounds))
 	{
-		set_velocity_xy(0, 0);
-		body->SetTransform(level_spawn_position, 0);
+		respawn();
 	}
 }
\ No newline at end of file
@@ -10,7 +10,8 @@
 #include <box2d/box2d.h>
 #include <LDtkLoader/Entity.hpp>
 
-using namespace std;
+#include <Constants.hpp>
+#include <utils/StateHash.hpp>
 
 enum PlayerAnimationState
 {
@@ -21,22 +22,50 @@ enum PlayerAnimationState
     JUMP_FALL
 };
 
+// What the player wants to do this tick, decoupled from the keyboard so
+// headless simulations can drive the player from a script or an agent
+struct PlayerInput
+{
+    bool left = false;
+    bool right = false;
+
+    // only true on the tick the jump button went down
+    bool jump = false;
+
+    static PlayerInput from_keyboard();
+};
+
 class Player : public BaseEntity
 {
 private:
-    Texture2D sprite;
+    Texture2D sprite{};
+    PlayerInput input;
     b2Body *body{};
     b2Vec2 level_spawn_position;
 
+    // area (in world pixels) the player respawns when leaving
+    Rectangle respawn_bounds = {0, 0, GameConstants::WorldWidth, GameConstants::WorldHeight};
+
+    // players in the same group pass through each other, 0 means no group
+    int16 collision_group = 0;
+
     bool is_touching_floor = true;
     bool looking_right = true;
 
+    // events of the last update, used to trigger effects
+    bool jumped = false;
+    bool landed = false;
+
+    int respawn_count = 0;
+
     const float animation_frame_duration = 0.2f;
     float animation_ticker = animation_frame_duration;
 
     size_t current_anim_frame = 0;
     PlayerAnimationState anim_state = PlayerAnimationState::IDLE;
-    unordered_map<PlayerAnimationState, vector<Rectangle>> animation_map;
+    std::unordered_map<PlayerAnimationState, std::vector<Rectangle>> animation_map;
+
+    void create_body(b2World *physicsWorld, b2Vec2 position);
 
     void set_velocity_x(float vx);
     void set_velocity_y(float vy);
@@ -50,11 +79,69 @@ private:
     void check_if_should_respawn();
 
 public:
+    // Everything about the player that changes while playing, used to save
+    // and restore simulations for rollback, see Simulation::save_state
+    struct State
+    {
+        b2Vec2 position;
+        b2Vec2 velocity;
+        b2Vec2 spawnPosition;
+        PlayerInput input;
+
+        bool isTouchingFloor;
+        bool lookingRight;
+        bool jumped;
+        bool landed;
+        int respawnCount;
+
+        float animationTicker;
+        size_t currentAnimFrame;
+        PlayerAnimationState animState;
+    };
+
     Player();
     ~Player();
 
+    // The sprite is only needed to draw, headless simulations never load it
+    void load_sprite();
+
+    // Input used by the following updates
+    void set_input(const PlayerInput &input);
+
+    // Should be called once per simulation tick, see GameConstants::TickDuration
     void update(float dt) override;
     void draw() override;
 
-    void init_for_level(const ldtk::Entity *entity, b2World *physicsWorld);
+    void init_for_level(const ldtk::Entity *entity, b2World *physicsWorld, Vector2 levelOffset = {0, 0});
+
+    // Box2D collision group of the bodies created from now on, players that
+    // share a world (e.g. a networked session) are put in the same negative
+    // group so they pass through each other
+    void set_collision_group(int16 group);
+    void set_respawn_bounds(Rectangle bounds);
+
+    // position in world pixels
+    Vector2 get_position() const;
+
+    // collision box in world pixels
+    Rectangle get_bounds() const;
+
+    // Sends the player back to the level's spawn point, e.g. after touching a hazard
+    void respawn();
+
+    bool has_jumped() const;
+    bool has_landed() const;
+    int get_respawn_count() const;
+
+    // Adds the gameplay state that isn't stored in the player's body
+    void add_to_hash(StateHash &hash) const;
+
+    State get_state() const;
+
+    // Gives the player a new body at its spawn point in `physicsWorld`, the
+    // old one is expected to have gone away with its world
+    void recreate_body(b2World *physicsWorld);
+
+    // Moves the player's body to where `state` had it
+    void set_state(const State &state);
 };
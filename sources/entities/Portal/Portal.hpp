@@ -1,5 +1,6 @@
 #pragma once
 
+#include <raylib.h>
 #include <box2d/box2d.h>
 #include <LDtkLoader/Entity.hpp>
 
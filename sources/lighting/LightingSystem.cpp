@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <cmath>
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+#include <utils/DebugUtils.hpp>
+
+#include "../rendering/RenderTargetStack.hpp"
+#include "LightingSystem.hpp"
+
+namespace
+{
+	// what's left of the scene where no light reaches
+	constexpr Color AmbientLight = {70, 70, 90, 255};
+}
+
+LightingSystem::LightingSystem() = default;
+
+LightingSystem::~LightingSystem()
+{
+	if (lightTarget.id != 0)
+	{
+		UnloadRenderTexture(lightTarget);
+	}
+}
+
+void LightingSystem::load_level(const ldtk::Level *level, const CollisionGrid &grid, Vector2 levelOffset)
+{
+	set_occluders(grid);
+	clear_lights();
+
+	for (auto &&entity : level->getLayer("Entities").allEntities())
+	{
+		if (entity.getName() != "Light")
+		{
+			continue;
+		}
+
+		PointLight light{
+			.position = {
+				levelOffset.x + entity.getPosition().x + entity.getSize().x / 2.0f,
+				levelOffset.y + entity.getPosition().y + entity.getSize().y / 2.0f,
+			},
+			.radius = LightingConstants::DefaultLightRadius,
+			.color = WHITE,
+		};
+
+		if (entity.hasField("radius") && !entity.getField<float>("radius").is_null())
+		{
+			light.radius = entity.getField<float>("radius").value();
+		}
+
+		if (entity.hasField("color") && !entity.getField<ldtk::Color>("color").is_null())
+		{
+			auto color = entity.getField<ldtk::Color>("color").value();
+			light.color = {color.r, color.g, color.b, 255};
+		}
+
+		add_light(light);
+	}
+
+	DebugUtils::println("Lighting has {} lights and {} occluder segments", lights.size(), shadowCaster.get_occluders().size());
+}
+
+void LightingSystem::set_occluders(const CollisionGrid &grid)
+{
+	shadowCaster.set_occluders(grid);
+	invalidate_polygons();
+}
+
+void LightingSystem::invalidate_polygons()
+{
+	for (auto &&state : lights)
+	{
+		state.polygonValid = false;
+	}
+}
+
+void LightingSystem::allocate_light_target(int width, int height)
+{
+	if (lightTarget.id != 0)
+	{
+		UnloadRenderTexture(lightTarget);
+	}
+
+	DebugUtils::println("Allocating the light target at {}x{}", width, height);
+	lightTarget = LoadRenderTexture(width, height);
+}
+
+void LightingSystem::clear_lights()
+{
+	lights.clear();
+}
+
+int LightingSystem::add_light(const PointLight &light)
+{
+	lights.push_back({.light = light});
+	return (int)lights.size() - 1;
+}
+
+void LightingSystem::move_light(int light, Vector2 position)
+{
+	auto &state = lights[light];
+	state.light.position = position;
+	state.polygonValid = false;
+}
+
+void LightingSystem::handle_input()
+{
+	if (IsKeyPressed(KEY_F3))
+	{
+		set_enabled(!enabled);
+	}
+}
+
+void LightingSystem::set_enabled(bool enabled)
+{
+	this->enabled = enabled;
+}
+
+bool LightingSystem::is_enabled() const
+{
+	return enabled;
+}
+
+void LightingSystem::add_light_triangles(const LightState &state) const
+{
+	const auto &light = state.light;
+	const auto &polygon = state.polygon;
+	const int count = (int)polygon.size();
+
+	// fades out linearly towards the radius
+	auto vertex = [&](Vector2 point)
+	{
+		float dx = point.x - light.position.x;
+		float dy = point.y - light.position.y;
+		float falloff = 1.0f - std::min(std::sqrt(dx * dx + dy * dy) / light.radius, 1.0f);
+		rlColor4ub((unsigned char)(light.color.r * falloff),
+				   (unsigned char)(light.color.g * falloff),
+				   (unsigned char)(light.color.b * falloff),
+				   255);
+		rlVertex2f(point.x, point.y);
+	};
+
+	for (int i = 0; i < count; i++)
+	{
+		rlColor4ub(light.color.r, light.color.g, light.color.b, 255);
+		rlVertex2f(light.position.x, light.position.y);
+		vertex(polygon[i]);
+		vertex(polygon[(i + 1) % count]);
+	}
+}
+
+void LightingSystem::draw(const Camera2D &camera)
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	stats = {};
+
+	// one light texel per pixel of the target it's multiplied onto
+	auto pixelSize = RenderTargetStack::get_pixel_size();
+	auto logicalSize = RenderTargetStack::get_logical_size();
+	if (lightTarget.texture.width != (int)pixelSize.x || lightTarget.texture.height != (int)pixelSize.y)
+	{
+		allocate_light_target((int)pixelSize.x, (int)pixelSize.y);
+	}
+
+	Rectangle view = {
+		camera.target.x - camera.offset.x / camera.zoom,
+		camera.target.y - camera.offset.y / camera.zoom,
+		logicalSize.x / camera.zoom,
+		logicalSize.y / camera.zoom,
+	};
+
+	RenderTargetStack::push(lightTarget, logicalSize.x, logicalSize.y);
+	ClearBackground(AmbientLight);
+
+	BeginMode2D(camera);
+	BeginBlendMode(BLEND_ADDITIVE);
+
+	// the polygons wind clockwise on screen
+	rlDisableBackfaceCulling();
+	rlBegin(RL_TRIANGLES);
+
+	for (auto &&state : lights)
+	{
+		if (!CheckCollisionCircleRec(state.light.position, state.light.radius, view))
+		{
+			stats.culledLights++;
+			continue;
+		}
+
+		if (!state.light.isStatic || !state.polygonValid)
+		{
+			shadowCaster.compute(state.light.position, state.light.radius, state.polygon);
+			state.polygonValid = true;
+			stats.computedPolygons++;
+		}
+
+		add_light_triangles(state);
+		stats.drawnLights++;
+	}
+
+	rlEnd();
+
+	// culling is GL state, so the triangles have to be drawn before it's back on
+	rlDrawRenderBatchActive();
+	rlEnableBackfaceCulling();
+
+	EndBlendMode();
+	EndMode2D();
+	RenderTargetStack::pop();
+
+	BeginBlendMode(BLEND_MULTIPLIED);
+	DrawTexturePro(lightTarget.texture,
+				   {0, 0, (float)lightTarget.texture.width, (float)-lightTarget.texture.height},
+				   {0, 0, logicalSize.x, logicalSize.y},
+				   {0, 0},
+				   0,
+				   WHITE);
+	EndBlendMode();
+}
+
+const LightingSystem::Stats &LightingSystem::get_stats() const
+{
+	return stats;
+}
+
+int LightingSystem::get_light_count() const
+{
+	return (int)lights.size();
+}
+
+int LightingSystem::get_occluder_count() const
+{
+	return (int)shadowCaster.get_occluders().size();
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+#include <LDtkLoader/Level.hpp>
+
+#include "../physics/CollisionGrid.hpp"
+#include "ShadowCaster.hpp"
+
+struct PointLight
+{
+    // world pixels
+    Vector2 position;
+    float radius;
+    Color color;
+
+    // static lights never move, what they light is worked out once and
+    // reused until the occluders change
+    bool isStatic = true;
+};
+
+/**
+ * 2D lighting with hard shadows from the level's solid cells. Every frame the
+ * lights that touch the view are added up into a light texture as big as
+ * the render target being drawn to (the game's, which shrinks on lower
+ * quality levels), starting from a dim ambient light, and the texture is
+ * then multiplied onto everything drawn so far.
+ *
+ * Lights come from the level's `Light` entities, which may set these fields:
+ *
+ *   radius (Float) reach in pixels, LightingConstants::DefaultLightRadius if unset
+ *   color  (Color) white if unset
+ *
+ * F3 toggles lighting at runtime.
+ */
+class LightingSystem
+{
+public:
+    struct Stats
+    {
+        int drawnLights = 0;
+        int culledLights = 0;
+        // visibility polygons computed this frame, static lights only count
+        // after they moved or the occluders changed
+        int computedPolygons = 0;
+    };
+
+private:
+    struct LightState
+    {
+        PointLight light;
+        std::vector<Vector2> polygon;
+        bool polygonValid = false;
+    };
+
+    ShadowCaster shadowCaster;
+    std::vector<LightState> lights;
+
+    // allocated on the first draw and again whenever the target drawn to
+    // changes size
+    RenderTexture2D lightTarget{};
+    bool enabled = true;
+
+    Stats stats;
+
+    void invalidate_polygons();
+    void allocate_light_target(int width, int height);
+    void add_light_triangles(const LightState &state) const;
+
+public:
+    LightingSystem();
+    ~LightingSystem();
+
+    LightingSystem(const LightingSystem &) = delete;
+    LightingSystem &operator=(const LightingSystem &) = delete;
+
+    // Replaces the occluders with the grid's and the lights with the level's
+    void load_level(const ldtk::Level *level, const CollisionGrid &grid, Vector2 levelOffset = {0, 0});
+
+    // Only replaces the occluders, lights are kept
+    void set_occluders(const CollisionGrid &grid);
+
+    void clear_lights();
+
+    // Returns the light's index for move_light
+    int add_light(const PointLight &light);
+    void move_light(int light, Vector2 position);
+
+    // F3 toggles lighting
+    void handle_input();
+
+    void set_enabled(bool enabled);
+    bool is_enabled() const;
+
+    // Lights everything drawn into the current render target so far.
+    // `camera` maps world pixels to that target, call outside of BeginMode2D.
+    void draw(const Camera2D &camera);
+
+    const Stats &get_stats() const;
+    int get_light_count() const;
+    int get_occluder_count() const;
+};
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cmath>
+
+#include <Constants.hpp>
+
+#include "ShadowCaster.hpp"
+
+namespace
+{
+	// rays are cast this far (in radians) to both sides of every corner, so
+	// they slip past it and hit whatever is behind
+	constexpr float CornerOffset = 0.0001f;
+
+	float cross(Vector2 a, Vector2 b)
+	{
+		return a.x * b.y - a.y * b.x;
+	}
+}
+
+void ShadowCaster::set_occluders(const CollisionGrid &grid)
+{
+	occluders.clear();
+
+	const auto origin = grid.get_origin();
+	const float cellSize = (float)grid.get_cell_size();
+	const int width = grid.get_width();
+	const int height = grid.get_height();
+
+	auto add = [&](int fromX, int fromY, int toX, int toY)
+	{
+		occluders.push_back({
+			{origin.x + fromX * cellSize, origin.y + fromY * cellSize},
+			{origin.x + toX * cellSize, origin.y + toY * cellSize},
+		});
+	};
+
+	// horizontal edges, between the rows above and below line `y`
+	for (int y = 0; y <= height; y++)
+	{
+		int runStart = -1;
+		for (int x = 0; x <= width; x++)
+		{
+			bool edge = x < width && grid.is_solid_cell(x, y - 1) != grid.is_solid_cell(x, y);
+			if (edge && runStart < 0)
+			{
+				runStart = x;
+			}
+			else if (!edge && runStart >= 0)
+			{
+				add(runStart, y, x, y);
+				runStart = -1;
+			}
+		}
+	}
+
+	// vertical edges, between the columns left and right of line `x`
+	for (int x = 0; x <= width; x++)
+	{
+		int runStart = -1;
+		for (int y = 0; y <= height; y++)
+		{
+			bool edge = y < height && grid.is_solid_cell(x - 1, y) != grid.is_solid_cell(x, y);
+			if (edge && runStart < 0)
+			{
+				runStart = y;
+			}
+			else if (!edge && runStart >= 0)
+			{
+				add(x, runStart, x, y);
+				runStart = -1;
+			}
+		}
+	}
+}
+
+void ShadowCaster::clear_occluders()
+{
+	occluders.clear();
+}
+
+const std::vector<OccluderSegment> &ShadowCaster::get_occluders() const
+{
+	return occluders;
+}
+
+float ShadowCaster::cast_ray(Vector2 origin, Vector2 direction, float radius) const
+{
+	float nearest = radius;
+	for (auto &&occluder : nearbyOccluders)
+	{
+		Vector2 edge = {occluder.b.x - occluder.a.x, occluder.b.y - occluder.a.y};
+		float denominator = cross(direction, edge);
+
+		// parallel to the ray, its ends are hit by rays of their own
+		if (std::abs(denominator) < 1e-6f)
+		{
+			continue;
+		}
+
+		Vector2 toStart = {occluder.a.x - origin.x, occluder.a.y - origin.y};
+		float distance = cross(toStart, edge) / denominator;
+		float along = cross(toStart, direction) / denominator;
+
+		if (distance >= 0.0f && distance < nearest && along >= 0.0f && along <= 1.0f)
+		{
+			nearest = distance;
+		}
+	}
+
+	return nearest;
+}
+
+void ShadowCaster::compute(Vector2 origin, float radius, std::vector<Vector2> &polygon)
+{
+	const float radiusSquared = radius * radius;
+
+	nearbyOccluders.clear();
+	angles.clear();
+
+	for (int i = 0; i < LightingConstants::BoundaryRays; i++)
+	{
+		angles.push_back(-PI + 2.0f * PI * i / LightingConstants::BoundaryRays);
+	}
+
+	for (auto &&occluder : occluders)
+	{
+		// outside of the light's bounds, can't cast a shadow inside them
+		if (std::max(occluder.a.x, occluder.b.x) < origin.x - radius ||
+			std::min(occluder.a.x, occluder.b.x) > origin.x + radius ||
+			std::max(occluder.a.y, occluder.b.y) < origin.y - radius ||
+			std::min(occluder.a.y, occluder.b.y) > origin.y + radius)
+		{
+			continue;
+		}
+		nearbyOccluders.push_back(occluder);
+
+		for (auto &&end : {occluder.a, occluder.b})
+		{
+			float dx = end.x - origin.x;
+			float dy = end.y - origin.y;
+			if (dx * dx + dy * dy <= radiusSquared)
+			{
+				float angle = std::atan2(dy, dx);
+				angles.push_back(angle - CornerOffset);
+				angles.push_back(angle);
+				angles.push_back(angle + CornerOffset);
+			}
+		}
+
+		// where the occluder crosses the light's circle, the edge of its shadow
+		// would otherwise be cut off at the nearest boundary ray
+		Vector2 edge = {occluder.b.x - occluder.a.x, occluder.b.y - occluder.a.y};
+		Vector2 fromOrigin = {occluder.a.x - origin.x, occluder.a.y - origin.y};
+		float a = edge.x * edge.x + edge.y * edge.y;
+		float b = 2.0f * (fromOrigin.x * edge.x + fromOrigin.y * edge.y);
+		float c = fromOrigin.x * fromOrigin.x + fromOrigin.y * fromOrigin.y - radiusSquared;
+		float discriminant = b * b - 4.0f * a * c;
+		if (a > 0.0f && discriminant >= 0.0f)
+		{
+			float root = std::sqrt(discriminant);
+			for (float t : {(-b - root) / (2.0f * a), (-b + root) / (2.0f * a)})
+			{
+				if (t >= 0.0f && t <= 1.0f)
+				{
+					angles.push_back(std::atan2(fromOrigin.y + t * edge.y, fromOrigin.x + t * edge.x));
+				}
+			}
+		}
+	}
+
+	std::sort(angles.begin(), angles.end());
+
+	polygon.clear();
+	for (float angle : angles)
+	{
+		Vector2 direction = {std::cos(angle), std::sin(angle)};
+		float distance = cast_ray(origin, direction, radius);
+		polygon.push_back({origin.x + direction.x * distance, origin.y + direction.y * distance});
+	}
+}
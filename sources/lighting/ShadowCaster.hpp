@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+
+#include "../physics/CollisionGrid.hpp"
+
+struct OccluderSegment
+{
+    Vector2 a;
+    Vector2 b;
+};
+
+/**
+ * Works out what a point light can see. The occluders are the outline of a
+ * level's solid cells, built once per level with every run of cell edges on
+ * the same line merged into one segment, so a long floor is a single segment
+ * no matter how many colliders it's made of.
+ *
+ * A visibility polygon is found by casting rays from the light at every
+ * occluder corner (and right beside it), where the occluders cross the
+ * light's circle and at regular steps around it, then sorting the hits by
+ * angle. All positions are in world pixels.
+ */
+class ShadowCaster
+{
+private:
+    std::vector<OccluderSegment> occluders;
+
+    // scratch space of `compute`, kept so steady-state frames don't allocate
+    std::vector<OccluderSegment> nearbyOccluders;
+    std::vector<float> angles;
+
+    float cast_ray(Vector2 origin, Vector2 direction, float radius) const;
+
+public:
+    // Replaces the occluders with the outline of the grid's solid cells
+    void set_occluders(const CollisionGrid &grid);
+    void clear_occluders();
+
+    const std::vector<OccluderSegment> &get_occluders() const;
+
+    // Fills `polygon` with the edge of the area lit by a light at `origin`,
+    // in angle order around it. Draw it as a triangle fan around `origin`.
+    void compute(Vector2 origin, float radius, std::vector<Vector2> &polygon);
+};
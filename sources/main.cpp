@@ -2,39 +2,206 @@
 #include <emscripten/emscripten.h>
 #endif
 
-#define RAYGUI_IMPLEMENTATION
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include <raylib.h>
 #include <raygui.h>
+#include <LDtkLoader/Project.hpp>
 
 #include <Constants.hpp>
+#include <utils/AllocationTracker.hpp>
+#include <utils/AssetRegistry.hpp>
+#include <utils/StateHash.hpp>
 
+#include "audio/AudioEngine.hpp"
 #include "entities/Player/Player.hpp"
+#include "rendering/QualityGovernor.hpp"
+#include "rendering/UpscalePipeline.hpp"
 #include "scenes/SceneManager.hpp"
 #include "scenes/Scenes.hpp"
+#include "net/LoopbackNetwork.hpp"
+#include "net/RollbackSession.hpp"
+#include "world/BatchRunner.hpp"
+#include "world/Simulation.hpp"
 
 void UpdateDrawFrame();
-RenderTexture2D gameRenderTexture; // Render texture for the game world
+void DrawFrame(float dt);
+int RunHeadless(int frames);
+int RunSimulations(const BatchRunner::Options &options);
+int RunDeterminismCheck(int ticks);
+int RunRollbackCheck(int ticks);
+bool ParseUpscaleOption(std::string_view option, std::string_view value, UpscaleConfig &config);
+std::unique_ptr<UpscalePipeline> upscalePipeline; // Takes the game world from its render texture to the window
 
-int main()
+// Used to report how long it takes to get the first frame on screen
+const auto startTime = std::chrono::steady_clock::now();
+bool firstFrameDrawn = false;
+
+int main(int argc, char **argv)
 {
+	// `--headless <frames>` runs the game scene in a hidden window for a fixed
+	// number of frames and then exits. Non-zero exit code means a check failed.
+	// `--simulate <instances> <ticks> [threads]` plays levels with random input
+	// on many simulations at once, without opening a window at all.
+	// `--check-determinism <ticks>` plays every level twice with the same input
+	// and fails if the runs diverge, it also prints a hash to compare builds.
+	// `--check-rollback <ticks>` plays a two player rollback session over a
+	// simulated bad network and fails if the peers desync.
+	// `--scale-mode integer|letterbox|stretch`, `--filter nearest|bilinear`,
+	// `--render-scale <n>` and `--post crt,bloom` choose how the game is
+	// scaled to the window and which post-process passes run.
+	// `--no-audio` runs without an audio device, `--audio-wav <path>` writes
+	// the mix to a WAV file instead (headless runs never use the device) and
+	// `--music <path>` streams a music file in a loop.
+	// `--quality auto|high|medium|low|lowest` pins the quality level or lets
+	// the governor pick it (the default), `--quality-target <ms>` overrides
+	// the platform's frame time target and `--quality-trace <path>` writes
+	// every governor decision to a file, one JSON object per line.
+	int headlessFrames = 0;
+	int determinismTicks = 0;
+	int rollbackTicks = 0;
+	BatchRunner::Options simulateOptions{.instanceCount = 0};
+	UpscaleConfig upscaleConfig;
+	AudioOutput audioOutput = AudioOutput::DEVICE;
+	std::string audioWavPath;
+	std::string musicPath;
+	auto qualityProfile = QualityGovernor::get_platform_profile();
+	int qualityLevel = -1;
+	std::string qualityTracePath;
+	for (int i = 1; i < argc; i++)
+	{
+		auto arg = std::string_view(argv[i]);
+		if (arg == "--headless" && i + 1 < argc)
+		{
+			headlessFrames = std::atoi(argv[++i]);
+		}
+		else if (arg == "--no-audio")
+		{
+			audioOutput = AudioOutput::NONE;
+		}
+		else if (arg == "--audio-wav" && i + 1 < argc)
+		{
+			audioOutput = AudioOutput::WAV_FILE;
+			audioWavPath = argv[++i];
+		}
+		else if (arg == "--music" && i + 1 < argc)
+		{
+			musicPath = argv[++i];
+		}
+		else if (arg == "--quality" && i + 1 < argc)
+		{
+			auto name = std::string_view(argv[++i]);
+			qualityLevel = QualityGovernor::find_level(name);
+			if (qualityLevel < 0 && name != "auto")
+			{
+				TraceLog(LOG_WARNING, "Unknown quality level, letting the governor pick it");
+			}
+		}
+		else if (arg == "--quality-target" && i + 1 < argc)
+		{
+			char *end = nullptr;
+			const char *value = argv[++i];
+			float targetMs = std::strtof(value, &end);
+			if (end == value || *end != '\0' || !std::isfinite(targetMs) || targetMs <= 0)
+			{
+				TraceLog(LOG_WARNING, "Quality target must be a frame time in milliseconds, keeping the %s profile's", qualityProfile.name);
+			}
+			else
+			{
+				qualityProfile.targetFrameMs = targetMs;
+			}
+		}
+		else if (arg == "--quality-trace" && i + 1 < argc)
+		{
+			qualityTracePath = argv[++i];
+		}
+		else if (arg == "--check-determinism" && i + 1 < argc)
+		{
+			determinismTicks = std::atoi(argv[++i]);
+		}
+		else if (arg == "--check-rollback" && i + 1 < argc)
+		{
+			rollbackTicks = std::atoi(argv[++i]);
+		}
+		else if (arg == "--simulate" && i + 2 < argc)
+		{
+			simulateOptions.instanceCount = std::atoi(argv[++i]);
+			simulateOptions.ticks = std::atoi(argv[++i]);
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+			{
+				simulateOptions.threadCount = std::atoi(argv[++i]);
+			}
+		}
+		else if (arg.starts_with("--") && i + 1 < argc && ParseUpscaleOption(arg, argv[i + 1], upscaleConfig))
+		{
+			i++;
+		}
+	}
+
+	if (simulateOptions.instanceCount > 0)
+	{
+		return RunSimulations(simulateOptions);
+	}
+
+	if (determinismTicks > 0)
+	{
+		return RunDeterminismCheck(determinismTicks);
+	}
+
+	if (rollbackTicks > 0)
+	{
+		return RunRollbackCheck(rollbackTicks);
+	}
+
+	unsigned int windowFlags = FLAG_WINDOW_RESIZABLE;
+	if (headlessFrames > 0)
+	{
+		windowFlags |= FLAG_WINDOW_HIDDEN;
+	}
+	SetConfigFlags(windowFlags);
+
 	InitWindow(
 		AppConstants::ScreenWidth,
 		AppConstants::ScreenHeight,
-		AppConstants::WindowTitle.c_str());
+		AppConstants::WindowTitle.data());
 
 	GuiLoadStyleDefault();
 
-	// Create render texture at game resolution (not screen resolution)
-	gameRenderTexture = LoadRenderTexture(GameConstants::WorldWidth, GameConstants::WorldHeight);
+	// The game renders at game resolution (not screen resolution) and is scaled up to the window
+	upscalePipeline = std::make_unique<UpscalePipeline>(upscaleConfig);
+
+	// headless runs still mix every sound, just not on the device
+	if (headlessFrames > 0 && audioOutput == AudioOutput::DEVICE)
+	{
+		audioOutput = AudioOutput::NONE;
+	}
+	AudioEngine::init(audioOutput, audioWavPath);
+	QualityGovernor::init(upscalePipeline.get(), qualityProfile, qualityLevel, qualityTracePath);
+
+	if (!musicPath.empty())
+	{
+		AudioEngine::play_music(musicPath);
+	}
 
 	SceneManager::initialize();
+
+	if (headlessFrames > 0)
+	{
+		return RunHeadless(headlessFrames);
+	}
+
 	SceneManager::set_current_screen(Scenes::TITLE);
 
 #if defined(PLATFORM_WEB)
 	emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
 #else
-	SetTargetFPS(60); // Set our game to run at 60 frames-per-second
+	SetTargetFPS(AppConstants::TargetFps);
 	//--------------------------------------------------------------------------------------
 
 	// Main game loop
@@ -45,34 +212,273 @@ int main()
 #endif
 
 	SceneManager::cleanup();
-	UnloadRenderTexture(gameRenderTexture);
+	AudioEngine::shutdown();
+	QualityGovernor::shutdown();
+	upscalePipeline.reset();
 	CloseWindow();
 	return 0;
 }
 
-void UpdateDrawFrame()
+int RunHeadless(int frames)
 {
-	float dt = GetFrameTime();
+	SceneManager::set_current_screen(Scenes::GAME);
+
+	// headless runs use a fixed timestep so they are reproducible
+	for (int i = 0; i < frames; i++)
+	{
+		DrawFrame(1.0f / 60.0f);
+	}
+
+	int exitCode = EXIT_SUCCESS;
+	if (AllocationTracker::budget_violations() > 0)
+	{
+		std::fprintf(stderr, "%zu frames went over the allocation budget\n", AllocationTracker::budget_violations());
+		exitCode = EXIT_FAILURE;
+	}
+
+	SceneManager::cleanup();
+	AudioEngine::shutdown();
+	QualityGovernor::shutdown();
+	upscalePipeline.reset();
+	CloseWindow();
+	return exitCode;
+}
+
+int RunSimulations(const BatchRunner::Options &options)
+{
+	ldtk::Project project;
+	project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+	auto start = std::chrono::steady_clock::now();
+	auto results = BatchRunner::run(&project.getWorld(), options, &BatchRunner::random_input);
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("%-10s %-6s %-20s %-6s %-8s\n", "instance", "level", "final position", "jumps", "respawns");
+	for (auto &&result : results)
+	{
+		std::printf("%-10d %-6d %8.1f, %-10.1f %-6d %-8d\n",
+					result.instance,
+					result.level,
+					result.finalPosition.x,
+					result.finalPosition.y,
+					result.jumps,
+					result.respawns);
+	}
+
+	double totalTicks = double(options.instanceCount) * options.ticks;
+	std::printf("\n%d instances x %d ticks on %d threads in %.2f s (%.0f ticks/s)\n",
+				options.instanceCount,
+				options.ticks,
+				BatchRunner::resolve_thread_count(options),
+				elapsed,
+				totalTicks / elapsed);
+
+	return EXIT_SUCCESS;
+}
+
+int RunDeterminismCheck(int ticks)
+{
+#if !defined(DETERMINISTIC_PHYSICS)
+	std::fprintf(stderr, "Not built with DETERMINISTIC_PHYSICS, hashes may differ between builds\n");
+#endif
+
+	ldtk::Project project;
+	project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+	const auto &levels = project.getWorld().allLevels();
+
+	int exitCode = EXIT_SUCCESS;
+	for (int level = 0; level < (int)levels.size(); level++)
+	{
+		// two independent simulations in lockstep, anything that leaks between
+		// them or isn't initialized makes their hashes differ
+		Simulation first;
+		Simulation second;
+		first.load_level(&levels[level]);
+		second.load_level(&levels[level]);
+
+		// hash of every tick's hash, so builds can be compared with a single line
+		StateHash trace;
+		for (int tick = 0; tick < ticks; tick++)
+		{
+			auto input = BatchRunner::random_input(level, tick);
+			first.step(input);
+			second.step(input);
 
+			auto hash = first.state_hash();
+			if (hash != second.state_hash())
+			{
+				std::fprintf(stderr, "Level %d diverged on tick %d\n", level, tick);
+				exitCode = EXIT_FAILURE;
+				break;
+			}
+
+			trace.add(hash);
+		}
+
+		std::printf("state-hash level %d ticks %d %016llx\n", level, ticks, (unsigned long long)trace.get());
+	}
+
+	return exitCode;
+}
+
+int RunRollbackCheck(int ticks)
+{
+	ldtk::Project project;
+	project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+	const auto *level = &project.getWorld().getLevel(0);
+
+	// bad enough that late inputs regularly need the full rollback window
+	LoopbackNetwork network({.latencyTicks = 6, .jitterTicks = 3, .lossRate = 0.1f});
+	RollbackSession sessions[] = {
+		RollbackSession(level, network.get_endpoint(0), {.localPlayer = 0}),
+		RollbackSession(level, network.get_endpoint(1), {.localPlayer = 1}),
+	};
+
+	for (int tick = 0; tick < ticks; tick++)
+	{
+		for (int player = 0; player < 2; player++)
+		{
+			sessions[player].advance(BatchRunner::random_input(player, tick));
+		}
+		network.advance();
+	}
+
+	int exitCode = EXIT_SUCCESS;
+	for (int player = 0; player < 2; player++)
+	{
+		const auto &metrics = sessions[player].get_metrics();
+		double averageDepth = metrics.rollbacks > 0 ? double(metrics.resimulatedTicks) / metrics.rollbacks : 0.0;
+
+		std::printf("player %d: reached tick %d, %d rollbacks (average depth %.1f, max %d), "
+					"worst re-simulation %.3f ms, worst frame %.3f ms, %d stalls, %d/%d hash checks failed\n",
+					player,
+					sessions[player].get_current_tick(),
+					metrics.rollbacks,
+					averageDepth,
+					metrics.maxRollbackDepth,
+					metrics.maxResimulationMs,
+					metrics.maxFrameMs,
+					metrics.stalls,
+					metrics.desyncs,
+					metrics.hashChecks);
+
+		if (metrics.desyncs > 0 || metrics.hashChecks == 0)
+		{
+			exitCode = EXIT_FAILURE;
+		}
+	}
+
+	return exitCode;
+}
+
+void UpdateDrawFrame()
+{
 	if (IsKeyDown(KEY_Q))
 	{
 		CloseWindow();
 		return;
 	}
 
-	BeginTextureMode(gameRenderTexture);
+	DrawFrame(GetFrameTime());
+}
+
+void DrawFrame(float dt)
+{
+	AllocationTracker::begin_frame();
+
+	// the window may have been resized, scenes need the mouse mapped to the new layout
+	upscalePipeline->update_layout();
+
+	upscalePipeline->begin_game();
 	ClearBackground(RAYWHITE);
 	
 	SceneManager::tick(dt);
 	
-	EndTextureMode();
+	upscalePipeline->end_game();
+
+	AudioEngine::update(dt);
 
 	BeginDrawing();
 	ClearBackground(BLACK);
 	
-	Rectangle source = { 0.0f, 0.0f, (float)gameRenderTexture.texture.width, (float)-gameRenderTexture.texture.height };
-	Rectangle dest = { 0.0f, 0.0f, AppConstants::ScreenWidth, AppConstants::ScreenHeight };
-	DrawTexturePro(gameRenderTexture.texture, source, dest, Vector2{ 0, 0 }, 0.0f, WHITE);
-	
+	upscalePipeline->present();
+
 	EndDrawing();
-}
\ No newline at end of file
+
+	AllocationTracker::end_frame();
+
+	// may reallocate render textures, so not while drawing. The frame time
+	// includes waiting for the swap, where the GPU's share of the frame shows.
+	QualityGovernor::record_frame(GetFrameTime() * 1000.0f);
+
+	if (!firstFrameDrawn)
+	{
+		firstFrameDrawn = true;
+		auto sinceStart = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+		TraceLog(LOG_INFO, "Time to first frame: %.1f ms since startup", sinceStart.count());
+#if defined(PLATFORM_WEB)
+		// performance.now() counts from navigation start, so this includes downloading the page and preloaded assets
+		TraceLog(LOG_INFO, "Time to first frame: %.1f ms since page navigation", emscripten_get_now());
+#endif
+	}
+}
+
+bool ParseUpscaleOption(std::string_view option, std::string_view value, UpscaleConfig &config)
+{
+	if (option == "--scale-mode")
+	{
+		if (value == "integer")
+		{
+			config.scaleMode = ScaleMode::INTEGER;
+		}
+		else if (value == "letterbox")
+		{
+			config.scaleMode = ScaleMode::LETTERBOX;
+		}
+		else if (value == "stretch")
+		{
+			config.scaleMode = ScaleMode::STRETCH;
+		}
+		else
+		{
+			TraceLog(LOG_WARNING, "Unknown scale mode, using integer scaling");
+		}
+	}
+	else if (option == "--filter")
+	{
+		config.filter = value == "bilinear" ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT;
+	}
+	else if (option == "--render-scale")
+	{
+		config.renderScale = std::atoi(value.data());
+	}
+	else if (option == "--post")
+	{
+		// comma separated list of passes, applied in order
+		while (!value.empty())
+		{
+			auto comma = value.find(',');
+			auto name = value.substr(0, comma);
+			value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+
+			if (name == "crt")
+			{
+				config.postEffects.push_back(PostEffect::CRT);
+			}
+			else if (name == "bloom")
+			{
+				config.postEffects.push_back(PostEffect::BLOOM);
+			}
+			else
+			{
+				TraceLog(LOG_WARNING, "Unknown post effect, ignoring it");
+			}
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <limits>
+
+#include "FlowField.hpp"
+
+namespace
+{
+	constexpr int Unreachable = std::numeric_limits<int>::max();
+}
+
+FlowField::FlowField(const NavigationGraph *graph)
+	: graph(graph),
+	  distances(graph->get_node_count(), Unreachable),
+	  nextNodes(graph->get_node_count(), -1),
+	  nextTypes(graph->get_node_count(), NavLinkType::WALK)
+{
+	// every link relaxes at most once, so the heap never outgrows this
+	open.reserve(graph->get_link_count() + 1);
+}
+
+void FlowField::begin(int targetNode)
+{
+	target = targetNode;
+	complete = false;
+
+	std::fill(distances.begin(), distances.end(), Unreachable);
+	std::fill(nextNodes.begin(), nextNodes.end(), -1);
+	open.clear();
+
+	if (target < 0)
+	{
+		complete = true;
+		return;
+	}
+
+	distances[target] = 0;
+	nextNodes[target] = target;
+	open.push_back({0, target});
+}
+
+bool FlowField::advance(int maxNodes)
+{
+	auto later = [](const OpenNode &a, const OpenNode &b)
+	{
+		return a.distance > b.distance;
+	};
+
+	int settled = 0;
+	while (!open.empty() && settled < maxNodes)
+	{
+		std::pop_heap(open.begin(), open.end(), later);
+		auto current = open.back();
+		open.pop_back();
+
+		// a shorter way to this node was found after it was queued
+		if (current.distance > distances[current.node])
+		{
+			continue;
+		}
+		settled++;
+
+		// whoever can get to the current node gets here through it
+		for (auto &&link : graph->get_incoming_links(current.node))
+		{
+			int distance = current.distance + link.cost;
+			if (distance < distances[link.node])
+			{
+				distances[link.node] = distance;
+				nextNodes[link.node] = current.node;
+				nextTypes[link.node] = link.type;
+				open.push_back({distance, link.node});
+				std::push_heap(open.begin(), open.end(), later);
+			}
+		}
+	}
+
+	complete = open.empty();
+	return complete;
+}
+
+bool FlowField::is_complete() const
+{
+	return complete;
+}
+
+int FlowField::get_target() const
+{
+	return target;
+}
+
+FlowField::Step FlowField::get_step(Vector2 position) const
+{
+	return get_step_from(graph->find_node(position));
+}
+
+FlowField::Step FlowField::get_step_from(int node) const
+{
+	if (node < 0 || nextNodes[node] < 0)
+	{
+		return {};
+	}
+
+	int next = nextNodes[node];
+	return {
+		.node = next,
+		.position = graph->get_node_position(next),
+		.type = nextTypes[node],
+		.distance = distances[node],
+	};
+}
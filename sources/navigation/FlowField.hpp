@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+#include "NavigationGraph.hpp"
+
+/**
+ * Shortest way from every node of a NavigationGraph to one target node. Once
+ * built, any number of agents can ask where to go next in constant time, no
+ * matter how far they are from the target.
+ *
+ * Built with Dijkstra from the target outwards over the incoming links, a
+ * slice of nodes at a time (see `advance`) so a build can be spread over
+ * several frames or abandoned when the target moves. Storage is allocated
+ * once for the graph's size, rebuilding doesn't allocate.
+ */
+class FlowField
+{
+public:
+    struct Step
+    {
+        // node to head to next, -1 when the target can't be reached (or the
+        // field isn't built yet). The target node itself once there.
+        int node = -1;
+
+        // where the agent's feet go, see NavigationGraph::get_node_position
+        Vector2 position{};
+
+        NavLinkType type = NavLinkType::WALK;
+
+        // cost left to reach the target from the current node
+        int distance = 0;
+    };
+
+private:
+    struct OpenNode
+    {
+        int distance;
+        int node;
+    };
+
+    const NavigationGraph *graph;
+
+    int target = -1;
+    bool complete = false;
+
+    std::vector<int> distances;
+    std::vector<int> nextNodes;
+    std::vector<NavLinkType> nextTypes;
+
+    // binary min-heap on distance, nodes may be in it several times and only
+    // the first time they come out counts
+    std::vector<OpenNode> open;
+
+public:
+    explicit FlowField(const NavigationGraph *graph);
+
+    // Throws away the current field and starts building one towards `targetNode`
+    void begin(int targetNode);
+
+    // Settles up to `maxNodes` more nodes, returns true once the field is complete
+    bool advance(int maxNodes);
+
+    bool is_complete() const;
+    int get_target() const;
+
+    // Constant time, `position` is an agent's feet in world pixels
+    Step get_step(Vector2 position) const;
+    Step get_step_from(int node) const;
+};
@@ -0,0 +1,155 @@
+#include <chrono>
+
+#include <Constants.hpp>
+
+#include "FlowFieldWorker.hpp"
+
+FlowFieldWorker::FlowFieldWorker(const NavigationGraph *graph)
+	: graph(graph), fields{FlowField(graph), FlowField(graph)}
+{
+#if !defined(PLATFORM_WEB)
+	thread = std::thread(&FlowFieldWorker::run, this);
+#endif
+}
+
+FlowFieldWorker::~FlowFieldWorker()
+{
+#if !defined(PLATFORM_WEB)
+	{
+		std::lock_guard lock(mutex);
+		stopping = true;
+	}
+
+	// makes a running build give up right away
+	latestTarget.store(-1);
+	wake.notify_one();
+	thread.join();
+#endif
+}
+
+#if !defined(PLATFORM_WEB)
+void FlowFieldWorker::run()
+{
+	while (true)
+	{
+		int target;
+		int back;
+		{
+			std::unique_lock lock(mutex);
+			wake.wait(lock, [this]
+					  { return stopping || (pendingTarget >= 0 && !backReady); });
+
+			if (stopping)
+			{
+				return;
+			}
+
+			target = pendingTarget;
+			pendingTarget = -1;
+			back = 1 - front;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		auto &field = fields[back];
+		field.begin(target);
+
+		bool outdated = false;
+		while (!field.advance(NavigationConstants::NodesPerSlice))
+		{
+			// the target moved on, the newer one is already pending
+			if (latestTarget.load(std::memory_order_relaxed) != target)
+			{
+				outdated = true;
+				break;
+			}
+		}
+
+		if (outdated)
+		{
+			continue;
+		}
+
+		lastBuildMs.store(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+		buildCount.fetch_add(1);
+
+		std::lock_guard lock(mutex);
+		backReady = true;
+	}
+}
+#endif
+
+void FlowFieldWorker::request(Vector2 target)
+{
+	int node = graph->find_node(target);
+	if (node < 0 || node == requestedNode)
+	{
+		return;
+	}
+	requestedNode = node;
+
+#if !defined(PLATFORM_WEB)
+	latestTarget.store(node, std::memory_order_relaxed);
+
+	std::lock_guard lock(mutex);
+	pendingTarget = node;
+	wake.notify_one();
+#else
+	pendingTarget = node;
+#endif
+}
+
+void FlowFieldWorker::update()
+{
+#if !defined(PLATFORM_WEB)
+	std::lock_guard lock(mutex);
+	if (backReady)
+	{
+		front = 1 - front;
+		backReady = false;
+		wake.notify_one();
+	}
+#else
+	auto &back = fields[1 - front];
+
+	// a newer target replaces whatever was being built
+	if (pendingTarget >= 0)
+	{
+		back.begin(pendingTarget);
+		pendingTarget = -1;
+		building = true;
+		buildMs = 0;
+	}
+
+	if (!building)
+	{
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	bool done = back.advance(NavigationConstants::NodesPerSlice);
+	buildMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	if (done)
+	{
+		front = 1 - front;
+		building = false;
+		lastBuildMs.store(buildMs);
+		buildCount.fetch_add(1);
+	}
+#endif
+}
+
+const FlowField &FlowFieldWorker::get_field() const
+{
+	return fields[front];
+}
+
+float FlowFieldWorker::get_last_build_ms() const
+{
+	return lastBuildMs.load();
+}
+
+int FlowFieldWorker::get_build_count() const
+{
+	return buildCount.load();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <raylib.h>
+
+#include "FlowField.hpp"
+#include "NavigationGraph.hpp"
+
+/**
+ * Keeps a FlowField towards a moving target (usually the player) up to date
+ * without costing the game thread anything but the lookups. The field is
+ * double buffered: agents read the front field while the worker thread
+ * builds the next one into the back field, and `update` swaps them once the
+ * back field is done. A build that is overtaken by a newer target is
+ * abandoned halfway.
+ *
+ * The web build has no threads, there `update` builds a slice of the back
+ * field every frame instead.
+ */
+class FlowFieldWorker
+{
+private:
+    const NavigationGraph *graph;
+
+    std::array<FlowField, 2> fields;
+    int front = 0;
+
+    // node last asked for, so a target that stays on the same node is free
+    int requestedNode = -1;
+
+    // target waiting for a build to start, -1 if none
+    int pendingTarget = -1;
+
+    std::atomic<float> lastBuildMs{0};
+    std::atomic<int> buildCount{0};
+
+#if !defined(PLATFORM_WEB)
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+
+    // `pendingTarget` and these are guarded by `mutex`. The worker only
+    // touches the back field while `backReady` is false, `update` only swaps
+    // the fields while it's true.
+    bool backReady = false;
+    bool stopping = false;
+
+    // lets a running build notice it's out of date without taking the lock
+    std::atomic<int> latestTarget{-1};
+
+    void run();
+#else
+    bool building = false;
+    float buildMs = 0;
+#endif
+
+public:
+    explicit FlowFieldWorker(const NavigationGraph *graph);
+    ~FlowFieldWorker();
+
+    FlowFieldWorker(const FlowFieldWorker &) = delete;
+    FlowFieldWorker &operator=(const FlowFieldWorker &) = delete;
+
+    // Asks for a field towards `target` (world pixels), ignored when the
+    // target is still on the same node as the last request
+    void request(Vector2 target);
+
+    // Once per frame, makes a finished field the one returned by get_field
+    void update();
+
+    // Stays valid and unchanged until the next `update`
+    const FlowField &get_field() const;
+
+    float get_last_build_ms() const;
+    int get_build_count() const;
+};
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <Constants.hpp>
+
+#include "NavigationGraph.hpp"
+
+namespace
+{
+	// relative costs of the links, jumps are slower and riskier than walking
+	constexpr int WalkCost = 2;
+	constexpr int FallCost = 2;
+	constexpr int JumpCost = 5;
+
+	// costs are stored in a byte, long falls all cost the same
+	constexpr int MaxCost = 255;
+
+	// link with its source, before the links are sorted into per node ranges
+	struct PendingLink
+	{
+		int from;
+		NavLink link;
+	};
+}
+
+NavigationGraph NavigationGraph::from_grid(const CollisionGrid &grid)
+{
+	using namespace NavigationConstants;
+
+	NavigationGraph graph;
+	graph.width = grid.get_width();
+	graph.height = grid.get_height();
+	graph.cellSize = grid.get_cell_size();
+	graph.origin = grid.get_origin();
+
+	const int width = graph.width;
+	const int height = graph.height;
+
+	// above the level is open air, beside it is a wall
+	auto is_free = [&](int x, int y)
+	{
+		return x >= 0 && x < width && !grid.is_solid_cell(x, y);
+	};
+
+	auto is_column_free = [&](int x, int fromY, int toY)
+	{
+		for (int y = fromY; y <= toY; y++)
+		{
+			if (!is_free(x, y))
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	auto has_room = [&](int x, int y)
+	{
+		return is_column_free(x, y - AgentHeightCells + 1, y);
+	};
+
+	graph.nodeAtCell.assign(width * height, -1);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			if (has_room(x, y) && grid.is_solid_cell(x, y + 1))
+			{
+				graph.nodeAtCell[y * width + x] = (int)graph.nodeCells.size();
+				graph.nodeCells.push_back(y * width + x);
+			}
+		}
+	}
+
+	// walk every column bottom up, remembering the last floor seen
+	graph.landingNodeAtCell.assign(width * height, -1);
+	for (int x = 0; x < width; x++)
+	{
+		int landing = -1;
+		for (int y = height - 1; y >= 0; y--)
+		{
+			int cell = y * width + x;
+			if (grid.is_solid_cell(x, y))
+			{
+				landing = -1;
+				continue;
+			}
+
+			if (graph.nodeAtCell[cell] >= 0)
+			{
+				landing = graph.nodeAtCell[cell];
+			}
+			graph.landingNodeAtCell[cell] = landing;
+		}
+	}
+
+	auto node_at = [&](int x, int y)
+	{
+		if (x < 0 || y < 0 || x >= width || y >= height)
+		{
+			return -1;
+		}
+		return graph.nodeAtCell[y * width + x];
+	};
+
+	std::vector<PendingLink> pending;
+	auto add_link = [&](int from, int to, NavLinkType type, int cost)
+	{
+		// a jump may reach a node that is also a walk or a fall away, keep the cheapest
+		for (auto it = pending.rbegin(); it != pending.rend() && it->from == from; ++it)
+		{
+			if (it->link.node == to)
+			{
+				if (cost < it->link.cost)
+				{
+					it->link = {to, type, (uint8_t)cost};
+				}
+				return;
+			}
+		}
+
+		pending.push_back({from, {to, type, (uint8_t)cost}});
+	};
+
+	for (int node = 0; node < (int)graph.nodeCells.size(); node++)
+	{
+		int x = graph.nodeCells[node] % width;
+		int y = graph.nodeCells[node] / width;
+
+		for (int direction : {-1, 1})
+		{
+			int nextX = x + direction;
+			if (node_at(nextX, y) >= 0)
+			{
+				add_link(node, node_at(nextX, y), NavLinkType::WALK, WalkCost);
+			}
+			else if (has_room(nextX, y))
+			{
+				// stepping off a ledge, the cell beside us has no floor
+				int landing = graph.landingNodeAtCell[y * width + nextX];
+				if (landing >= 0)
+				{
+					int drop = graph.nodeCells[landing] / width - y;
+					add_link(node, landing, NavLinkType::FALL, std::min(FallCost + drop, MaxCost));
+				}
+			}
+		}
+
+		// jumps go straight up until the feet are level with the higher end,
+		// across, then down
+		for (int targetY = y - JumpHeightCells; targetY <= y + JumpHeightCells; targetY++)
+		{
+			for (int targetX = x - JumpDistanceCells; targetX <= x + JumpDistanceCells; targetX++)
+			{
+				int target = node_at(targetX, targetY);
+				if (target < 0 || targetX == x || (std::abs(targetX - x) == 1 && targetY == y))
+				{
+					continue;
+				}
+
+				int apex = std::min(y, targetY);
+				int top = apex - AgentHeightCells + 1;
+				int step = targetX > x ? 1 : -1;
+
+				bool clear = is_column_free(x, top, y) && is_column_free(targetX, top, targetY);
+				for (int column = x + step; clear && column != targetX; column += step)
+				{
+					clear = is_column_free(column, top, apex);
+				}
+
+				if (clear)
+				{
+					add_link(node, target, NavLinkType::JUMP, JumpCost + std::abs(targetX - x) + std::abs(targetY - y));
+				}
+			}
+		}
+	}
+
+	// pending links are already grouped by source node, in node order
+	const int nodeCount = (int)graph.nodeCells.size();
+	graph.linkOffsets.assign(nodeCount + 1, 0);
+	graph.links.reserve(pending.size());
+	for (auto &&link : pending)
+	{
+		graph.linkOffsets[link.from + 1]++;
+		graph.links.push_back(link.link);
+	}
+	for (int node = 0; node < nodeCount; node++)
+	{
+		graph.linkOffsets[node + 1] += graph.linkOffsets[node];
+	}
+
+	graph.incomingOffsets.assign(nodeCount + 1, 0);
+	for (auto &&link : pending)
+	{
+		graph.incomingOffsets[link.link.node + 1]++;
+	}
+	for (int node = 0; node < nodeCount; node++)
+	{
+		graph.incomingOffsets[node + 1] += graph.incomingOffsets[node];
+	}
+
+	graph.incomingLinks.resize(pending.size());
+	std::vector<int> filled(graph.incomingOffsets.begin(), graph.incomingOffsets.end() - 1);
+	for (auto &&link : pending)
+	{
+		graph.incomingLinks[filled[link.link.node]++] = {link.from, link.link.type, link.link.cost};
+	}
+
+	return graph;
+}
+
+int NavigationGraph::get_node_count() const
+{
+	return (int)nodeCells.size();
+}
+
+int NavigationGraph::get_link_count() const
+{
+	return (int)links.size();
+}
+
+int NavigationGraph::find_node(Vector2 position) const
+{
+	int x = (int)std::floor((position.x - origin.x) / cellSize);
+	int y = (int)std::floor((position.y - origin.y) / cellSize);
+	if (x < 0 || x >= width || y >= height)
+	{
+		return -1;
+	}
+
+	// above the level, whatever is below the top row is where it lands
+	return landingNodeAtCell[std::max(y, 0) * width + x];
+}
+
+Vector2 NavigationGraph::get_node_position(int node) const
+{
+	int x = nodeCells[node] % width;
+	int y = nodeCells[node] / width;
+	return {origin.x + (x + 0.5f) * cellSize, origin.y + (y + 1.0f) * cellSize};
+}
+
+std::span<const NavLink> NavigationGraph::get_links(int node) const
+{
+	return std::span<const NavLink>(links).subspan(linkOffsets[node], linkOffsets[node + 1] - linkOffsets[node]);
+}
+
+std::span<const NavLink> NavigationGraph::get_incoming_links(int node) const
+{
+	return std::span<const NavLink>(incomingLinks).subspan(incomingOffsets[node], incomingOffsets[node + 1] - incomingOffsets[node]);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <raylib.h>
+
+#include "../physics/CollisionGrid.hpp"
+
+enum class NavLinkType : uint8_t
+{
+    // to the next cell on the same floor
+    WALK,
+    // off a ledge, straight down to the floor below
+    FALL,
+    // through the air to a floor up to NavigationConstants::JumpHeightCells higher
+    JUMP,
+};
+
+struct NavLink
+{
+    // the node at the other end, the target for outgoing links and the
+    // source for incoming ones
+    int node;
+    NavLinkType type;
+    uint8_t cost;
+};
+
+/**
+ * Where ground agents can stand in a level and how they get from one place to
+ * another. Every free cell with a solid cell right below it (and enough room
+ * above it) is a node, nodes are connected by walk, fall and jump links.
+ * Agents are treated as one cell wide and NavigationConstants::AgentHeightCells
+ * tall.
+ *
+ * Built once per level from its CollisionGrid, read only afterwards so any
+ * number of threads may use it.
+ */
+class NavigationGraph
+{
+private:
+    int width = 0;
+    int height = 0;
+    int cellSize = 0;
+    Vector2 origin{};
+
+    // -1 for cells an agent can't stand in
+    std::vector<int> nodeAtCell;
+
+    // first node at or below the cell that an agent in the cell would fall
+    // on, -1 if it would fall out of the level
+    std::vector<int> landingNodeAtCell;
+
+    std::vector<int> nodeCells;
+
+    // links of node `n` are [offsets[n], offsets[n + 1]) of the link array.
+    // Flow fields are built backwards from their target, so the incoming
+    // links are kept too.
+    std::vector<int> linkOffsets;
+    std::vector<NavLink> links;
+    std::vector<int> incomingOffsets;
+    std::vector<NavLink> incomingLinks;
+
+public:
+    static NavigationGraph from_grid(const CollisionGrid &grid);
+
+    int get_node_count() const;
+    int get_link_count() const;
+
+    // Node an agent at `position` (world pixels) stands on, or lands on if
+    // it's in the air. -1 outside of the level or over a pit.
+    int find_node(Vector2 position) const;
+
+    // Bottom center of the node's cell, where an agent's feet go
+    Vector2 get_node_position(int node) const;
+
+    std::span<const NavLink> get_links(int node) const;
+    std::span<const NavLink> get_incoming_links(int node) const;
+};
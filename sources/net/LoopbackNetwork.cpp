@@ -0,0 +1,69 @@
+#include <algorithm>
+
+#include "LoopbackNetwork.hpp"
+
+LoopbackNetwork::Endpoint::Endpoint(LoopbackNetwork &network, int index)
+	: network(network), index(index)
+{
+}
+
+void LoopbackNetwork::Endpoint::send(const uint8_t *data, size_t size)
+{
+	auto &conditions = network.conditions;
+
+	float roll = (network.next_random() & 0xFFFF) / 65536.0f;
+	if (roll < conditions.lossRate)
+	{
+		return;
+	}
+
+	int jitter = conditions.jitterTicks > 0 ? int(network.next_random() % (conditions.jitterTicks + 1)) : 0;
+	network.inFlight[1 - index].push_back({
+		.arrivalTick = network.currentTick + conditions.latencyTicks + jitter,
+		.data = std::vector<uint8_t>(data, data + size),
+	});
+}
+
+bool LoopbackNetwork::Endpoint::receive(std::vector<uint8_t> &datagram)
+{
+	auto &queue = network.inFlight[index];
+
+	// jitter reorders datagrams, so look for any that has arrived
+	auto arrived = std::find_if(queue.begin(), queue.end(), [&](const Datagram &candidate)
+								{ return candidate.arrivalTick <= network.currentTick; });
+
+	if (arrived == queue.end())
+	{
+		return false;
+	}
+
+	datagram = std::move(arrived->data);
+	queue.erase(arrived);
+	return true;
+}
+
+LoopbackNetwork::LoopbackNetwork(const Conditions &conditions)
+	: conditions(conditions),
+	  randomState(conditions.seed != 0 ? conditions.seed : 1),
+	  endpoints{Endpoint(*this, 0), Endpoint(*this, 1)}
+{
+}
+
+uint32_t LoopbackNetwork::next_random()
+{
+	// xorshift32, same as ParticleEmitter
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+Transport &LoopbackNetwork::get_endpoint(int index)
+{
+	return endpoints[index];
+}
+
+void LoopbackNetwork::advance()
+{
+	currentTick++;
+}
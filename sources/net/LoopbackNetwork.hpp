@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Transport.hpp"
+
+/**
+ * In-process network between two endpoints, for tests and benchmarks. Time
+ * is counted in ticks: datagrams arrive `latencyTicks` (plus up to
+ * `jitterTicks`) calls to `advance` after being sent, or are lost. Random
+ * decisions come from a seeded generator, so runs are reproducible.
+ */
+class LoopbackNetwork
+{
+public:
+    struct Conditions
+    {
+        int latencyTicks = 3;
+        int jitterTicks = 2;
+
+        // chance in [0, 1] of a datagram being dropped
+        float lossRate = 0.05f;
+
+        uint32_t seed = 0x2545F491u;
+    };
+
+private:
+    class Endpoint : public Transport
+    {
+    private:
+        LoopbackNetwork &network;
+        int index;
+
+    public:
+        Endpoint(LoopbackNetwork &network, int index);
+
+        void send(const uint8_t *data, size_t size) override;
+        bool receive(std::vector<uint8_t> &datagram) override;
+    };
+
+    struct Datagram
+    {
+        int arrivalTick;
+        std::vector<uint8_t> data;
+    };
+
+    Conditions conditions;
+    uint32_t randomState;
+    int currentTick = 0;
+
+    std::array<Endpoint, 2> endpoints;
+
+    // datagrams on their way to each endpoint
+    std::array<std::vector<Datagram>, 2> inFlight;
+
+    uint32_t next_random();
+
+public:
+    explicit LoopbackNetwork(const Conditions &conditions);
+
+    // Endpoint 0 talks to endpoint 1 and the other way around
+    Transport &get_endpoint(int index);
+
+    // Moves time forward by one tick
+    void advance();
+};
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <chrono>
+#include <span>
+
+#include <raylib.h>
+#include <LDtkLoader/Level.hpp>
+
+#include "RollbackSession.hpp"
+
+namespace
+{
+	// most inputs a single message carries, the session stalls long before
+	// this many are unacknowledged
+	constexpr int MaxInputsPerMessage = 32;
+
+	// datagrams are written byte by byte in little endian, so peers don't
+	// need to share struct layout or endianness
+	void write_u8(std::vector<uint8_t> &out, uint8_t value)
+	{
+		out.push_back(value);
+	}
+
+	void write_i32(std::vector<uint8_t> &out, int32_t value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			out.push_back(uint8_t(uint32_t(value) >> (i * 8)));
+		}
+	}
+
+	void write_u64(std::vector<uint8_t> &out, uint64_t value)
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			out.push_back(uint8_t(value >> (i * 8)));
+		}
+	}
+
+	struct Reader
+	{
+		const uint8_t *data;
+		size_t size;
+		size_t offset = 0;
+		bool ok = true;
+
+		uint64_t read_bytes(int count)
+		{
+			if (offset + count > size)
+			{
+				ok = false;
+				return 0;
+			}
+
+			uint64_t value = 0;
+			for (int i = 0; i < count; i++)
+			{
+				value |= uint64_t(data[offset++]) << (i * 8);
+			}
+			return value;
+		}
+
+		uint8_t read_u8() { return uint8_t(read_bytes(1)); }
+		int32_t read_i32() { return int32_t(uint32_t(read_bytes(4))); }
+		uint64_t read_u64() { return read_bytes(8); }
+	};
+
+	uint8_t pack_input(const PlayerInput &input)
+	{
+		return uint8_t(input.left) | uint8_t(input.right) << 1 | uint8_t(input.jump) << 2;
+	}
+
+	PlayerInput unpack_input(uint8_t bits)
+	{
+		return {
+			.left = (bits & 1) != 0,
+			.right = (bits & 2) != 0,
+			.jump = (bits & 4) != 0,
+		};
+	}
+
+	double milliseconds_since(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+RollbackSession::RollbackSession(const ldtk::Level *level, Transport &transport, const Config &config)
+	: config(config), transport(transport), simulation(PlayerCount), history(HistorySize)
+{
+	simulation.load_level(level);
+	simulation.save_state(record(0).state);
+
+	// the first `inputDelay` ticks can't have any input, both peers know that
+	for (int tick = 0; tick < config.inputDelay; tick++)
+	{
+		auto &tickRecord = record(tick);
+		for (int player = 0; player < PlayerCount; player++)
+		{
+			tickRecord.confirmed[player] = true;
+		}
+	}
+
+	lastRemoteTick = config.inputDelay - 1;
+	lastLocalTick = config.inputDelay - 1;
+	remoteAckTick = config.inputDelay - 1;
+}
+
+bool RollbackSession::advance(const PlayerInput &localInput)
+{
+	auto frameStart = std::chrono::steady_clock::now();
+
+	receive_messages();
+
+	// simulating this tick would mean predicting more ticks than we can roll back
+	if (currentTick - lastRemoteTick > config.maxRollback)
+	{
+		resimulate();
+		send_message();
+
+		metrics.stalls++;
+		metrics.lastFrameMs = milliseconds_since(frameStart);
+		metrics.maxFrameMs = std::max(metrics.maxFrameMs, metrics.lastFrameMs);
+		return false;
+	}
+
+	lastLocalTick = currentTick + config.inputDelay;
+	auto &localRecord = record(lastLocalTick);
+	localRecord.inputs[config.localPlayer] = localInput;
+	localRecord.confirmed[config.localPlayer] = true;
+
+	resimulate();
+
+	simulate_tick(currentTick);
+	currentTick++;
+
+	send_message();
+
+	metrics.lastFrameMs = milliseconds_since(frameStart);
+	metrics.maxFrameMs = std::max(metrics.maxFrameMs, metrics.lastFrameMs);
+	return true;
+}
+
+void RollbackSession::force_rollback(int depth)
+{
+	depth = std::clamp(depth, 0, std::min(currentTick, config.maxRollback));
+	if (depth > 0)
+	{
+		rollbackTick = currentTick - depth;
+		resimulate();
+	}
+}
+
+int RollbackSession::remote_player() const
+{
+	return 1 - config.localPlayer;
+}
+
+RollbackSession::TickRecord &RollbackSession::record(int tick)
+{
+	auto &tickRecord = history[tick % HistorySize];
+	if (tickRecord.tick != tick)
+	{
+		// the slot belonged to a tick too old to be rolled back to, reuse it
+		// (keeping the state's storage)
+		tickRecord.tick = tick;
+		std::fill(std::begin(tickRecord.inputs), std::end(tickRecord.inputs), PlayerInput{});
+		std::fill(std::begin(tickRecord.confirmed), std::end(tickRecord.confirmed), false);
+		tickRecord.hash = 0;
+		tickRecord.simulated = false;
+	}
+	return tickRecord;
+}
+
+PlayerInput RollbackSession::predict_remote_input()
+{
+	// the remote player keeps holding what they held last, but presses are
+	// one-off so a jump is never repeated
+	auto prediction = record(lastRemoteTick).inputs[remote_player()];
+	prediction.jump = false;
+	return prediction;
+}
+
+void RollbackSession::simulate_tick(int tick)
+{
+	auto &tickRecord = record(tick);
+	for (int player = 0; player < PlayerCount; player++)
+	{
+		if (!tickRecord.confirmed[player])
+		{
+			tickRecord.inputs[player] = predict_remote_input();
+		}
+	}
+
+	// forward ticks start from a loaded state too, so a re-simulated tick
+	// starts from exactly what its first run did and both peers step the same
+	// worlds whichever ticks they had to re-simulate
+	simulation.load_state(tickRecord.state);
+	simulation.step(std::span<const PlayerInput>(tickRecord.inputs));
+
+	tickRecord.hash = simulation.state_hash();
+	tickRecord.simulated = true;
+
+	simulation.save_state(record(tick + 1).state);
+}
+
+void RollbackSession::resimulate()
+{
+	if (rollbackTick < 0)
+	{
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	int depth = currentTick - rollbackTick;
+
+	for (int tick = rollbackTick; tick < currentTick; tick++)
+	{
+		simulate_tick(tick);
+	}
+	rollbackTick = -1;
+
+	metrics.rollbacks++;
+	metrics.lastRollbackDepth = depth;
+	metrics.maxRollbackDepth = std::max(metrics.maxRollbackDepth, depth);
+	metrics.resimulatedTicks += depth;
+	metrics.lastResimulationMs = milliseconds_since(start);
+	metrics.maxResimulationMs = std::max(metrics.maxResimulationMs, metrics.lastResimulationMs);
+}
+
+void RollbackSession::receive_messages()
+{
+	while (transport.receive(incoming))
+	{
+		handle_message(incoming.data(), incoming.size());
+	}
+}
+
+void RollbackSession::handle_message(const uint8_t *data, size_t size)
+{
+	Reader reader{data, size};
+
+	int firstTick = reader.read_i32();
+	int count = reader.read_u8();
+	if (!reader.ok || reader.offset + count > size)
+	{
+		return;
+	}
+
+	const uint8_t *inputs = data + reader.offset;
+	reader.offset += count;
+
+	int ackTick = reader.read_i32();
+	int hashTick = reader.read_i32();
+	uint64_t hash = reader.read_u64();
+	if (!reader.ok)
+	{
+		return;
+	}
+
+	remoteAckTick = std::max(remoteAckTick, ackTick);
+
+	// only take inputs that continue the ones we have, anything after a gap
+	// is sent again until we acknowledge it
+	for (int i = 0; i < count; i++)
+	{
+		int tick = firstTick + i;
+		if (tick != lastRemoteTick + 1 || tick >= currentTick + HistorySize / 2)
+		{
+			continue;
+		}
+
+		auto input = unpack_input(inputs[i]);
+		auto &tickRecord = record(tick);
+
+		if (tickRecord.simulated && pack_input(tickRecord.inputs[remote_player()]) != inputs[i])
+		{
+			// we predicted wrong, everything from this tick on has to be simulated again
+			rollbackTick = rollbackTick < 0 ? tick : std::min(rollbackTick, tick);
+		}
+
+		tickRecord.inputs[remote_player()] = input;
+		tickRecord.confirmed[remote_player()] = true;
+		lastRemoteTick = tick;
+	}
+
+	// compare with our own hash once we've simulated the tick with the final inputs
+	bool hashUsable = hashTick > lastCheckedHashTick &&
+					  hashTick < currentTick &&
+					  hashTick <= lastRemoteTick &&
+					  hashTick <= lastLocalTick &&
+					  (rollbackTick < 0 || hashTick < rollbackTick) &&
+					  history[hashTick % HistorySize].tick == hashTick;
+
+	if (hashUsable && history[hashTick % HistorySize].simulated)
+	{
+		lastCheckedHashTick = hashTick;
+		metrics.hashChecks++;
+
+		if (history[hashTick % HistorySize].hash != hash)
+		{
+			metrics.desyncs++;
+			TraceLog(LOG_WARNING, "Rollback session desynced on tick %d", hashTick);
+		}
+	}
+}
+
+void RollbackSession::send_message()
+{
+	int firstTick = std::max(remoteAckTick + 1, lastLocalTick - MaxInputsPerMessage + 1);
+	int count = std::max(lastLocalTick - firstTick + 1, 0);
+
+	// latest tick both players' inputs are known for and that has been simulated with them
+	int hashTick = std::min({lastRemoteTick, lastLocalTick, currentTick - 1});
+
+	outgoing.clear();
+	write_i32(outgoing, firstTick);
+	write_u8(outgoing, uint8_t(count));
+	for (int tick = firstTick; tick < firstTick + count; tick++)
+	{
+		write_u8(outgoing, pack_input(record(tick).inputs[config.localPlayer]));
+	}
+	write_i32(outgoing, lastRemoteTick);
+	write_i32(outgoing, hashTick);
+	write_u64(outgoing, hashTick >= 0 ? record(hashTick).hash : 0);
+
+	transport.send(outgoing.data(), outgoing.size());
+}
+
+const Simulation &RollbackSession::get_simulation() const
+{
+	return simulation;
+}
+
+const RollbackSession::Metrics &RollbackSession::get_metrics() const
+{
+	return metrics;
+}
+
+int RollbackSession::get_current_tick() const
+{
+	return currentTick;
+}
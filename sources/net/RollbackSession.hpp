@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+
+#include "Transport.hpp"
+#include "../world/Simulation.hpp"
+
+/**
+ * Two player session on one level using rollback: local input is applied
+ * `inputDelay` ticks in the future, the remote player's missing input is
+ * predicted (they keep holding what they last held), and when their real
+ * input arrives and differs from the prediction the simulation is restored
+ * to that tick and re-simulated up to the present.
+ *
+ * Every tick's starting state is kept in a ring buffer. Both peers exchange
+ * the state hash of the latest tick whose inputs they both know, so desyncs
+ * are detected instead of silently diverging.
+ */
+class RollbackSession
+{
+public:
+    struct Config
+    {
+        // 0 or 1, the other player is remote
+        int localPlayer = 0;
+        int inputDelay = NetworkConstants::InputDelay;
+        int maxRollback = NetworkConstants::MaxRollback;
+    };
+
+    struct Metrics
+    {
+        int rollbacks = 0;
+        int lastRollbackDepth = 0;
+        int maxRollbackDepth = 0;
+        long resimulatedTicks = 0;
+
+        // re-simulation and whole `advance` call times of the last frame and the worst one
+        double lastResimulationMs = 0;
+        double maxResimulationMs = 0;
+        double lastFrameMs = 0;
+        double maxFrameMs = 0;
+
+        // frames where the session waited for the remote player
+        int stalls = 0;
+
+        int hashChecks = 0;
+        int desyncs = 0;
+    };
+
+private:
+    static constexpr int PlayerCount = 2;
+
+    // must hold more than maxRollback + inputDelay ticks, plus whatever the
+    // remote player may be ahead of us
+    static constexpr int HistorySize = 64;
+
+    struct TickRecord
+    {
+        int tick = -1;
+        PlayerInput inputs[PlayerCount];
+        bool confirmed[PlayerCount] = {};
+
+        // state at the start of the tick, and the hash at its end
+        Simulation::State state;
+        uint64_t hash = 0;
+        bool simulated = false;
+    };
+
+    Config config;
+    Transport &transport;
+    Simulation simulation;
+
+    std::vector<TickRecord> history;
+
+    // next tick to simulate
+    int currentTick = 0;
+
+    // all remote inputs up to this tick have arrived
+    int lastRemoteTick = -1;
+
+    // latest tick we have the local input for
+    int lastLocalTick = -1;
+
+    // the remote player has all our inputs up to this tick
+    int remoteAckTick = -1;
+
+    // earliest tick simulated with a wrong prediction, -1 if none
+    int rollbackTick = -1;
+
+    int lastCheckedHashTick = -1;
+
+    Metrics metrics;
+
+    // reused to avoid allocating every frame
+    std::vector<uint8_t> incoming;
+    std::vector<uint8_t> outgoing;
+
+    int remote_player() const;
+    TickRecord &record(int tick);
+
+    PlayerInput predict_remote_input();
+    void simulate_tick(int tick);
+    void resimulate();
+
+    void receive_messages();
+    void handle_message(const uint8_t *data, size_t size);
+    void send_message();
+
+public:
+    RollbackSession(const ldtk::Level *level, Transport &transport, const Config &config);
+
+    // Advances the session by one tick using this frame's local input. Returns
+    // false if the session stalled waiting for the remote player, in which
+    // case the input is dropped.
+    bool advance(const PlayerInput &localInput);
+
+    // Treats the last `depth` ticks as mispredicted and re-simulates them, for
+    // measuring the worst case cost of a frame
+    void force_rollback(int depth);
+
+    const Simulation &get_simulation() const;
+    const Metrics &get_metrics() const;
+    int get_current_tick() const;
+};
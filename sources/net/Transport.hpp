@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Unreliable, unordered datagram channel to a single peer, with the same
+ * guarantees as UDP: datagrams may be dropped, duplicated or reordered, but
+ * are never split. RollbackSession only talks to the other player through
+ * this, so a socket based transport can replace LoopbackNetwork without
+ * touching the session.
+ */
+class Transport
+{
+public:
+    virtual ~Transport() = default;
+
+    virtual void send(const uint8_t *data, size_t size) = 0;
+
+    // Pops the next datagram that has arrived into `datagram`, returns false if there is none
+    virtual bool receive(std::vector<uint8_t> &datagram) = 0;
+};
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cmath>
+
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+
+#include "CollisionGrid.hpp"
+
+namespace
+{
+	// tiny inset so that rectangles which merely touch a cell border don't count as overlapping it
+	constexpr float Epsilon = 0.001f;
+}
+
+CollisionGrid::CollisionGrid() : cellSize(GameConstants::CellSize)
+{
+}
+
+CollisionGrid::CollisionGrid(int width, int height, Vector2 origin)
+	: width(width), height(height), cellSize(GameConstants::CellSize), origin(origin)
+{
+	bits.resize((width * height + 63) / 64, 0);
+}
+
+CollisionGrid CollisionGrid::from_level(const ldtk::Level *level, Vector2 origin)
+{
+	const int cellSize = GameConstants::CellSize;
+	CollisionGrid grid((level->size.x + cellSize - 1) / cellSize,
+					   (level->size.y + cellSize - 1) / cellSize,
+					   origin);
+
+	for (auto &&entity : level->getLayer("PhysicsEntities").allEntities())
+	{
+		int fromX = entity.getPosition().x / cellSize;
+		int fromY = entity.getPosition().y / cellSize;
+		int toX = (entity.getPosition().x + entity.getSize().x + cellSize - 1) / cellSize;
+		int toY = (entity.getPosition().y + entity.getSize().y + cellSize - 1) / cellSize;
+
+		for (int y = fromY; y < toY; y++)
+		{
+			for (int x = fromX; x < toX; x++)
+			{
+				grid.set_solid(x, y, true);
+			}
+		}
+	}
+
+	return grid;
+}
+
+int CollisionGrid::cell_x(float x) const
+{
+	return (int)std::floor((x - origin.x) / cellSize);
+}
+
+int CollisionGrid::cell_y(float y) const
+{
+	return (int)std::floor((y - origin.y) / cellSize);
+}
+
+void CollisionGrid::set_solid(int x, int y, bool solid)
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+	{
+		return;
+	}
+
+	int index = y * width + x;
+	if (solid)
+	{
+		bits[index / 64] |= (uint64_t(1) << (index % 64));
+	}
+	else
+	{
+		bits[index / 64] &= ~(uint64_t(1) << (index % 64));
+	}
+}
+
+bool CollisionGrid::is_solid_cell(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= width || y >= height)
+	{
+		return false;
+	}
+
+	int index = y * width + x;
+	return (bits[index / 64] >> (index % 64)) & 1;
+}
+
+bool CollisionGrid::is_any_solid(int fromX, int fromY, int toX, int toY) const
+{
+	for (int y = fromY; y <= toY; y++)
+	{
+		for (int x = fromX; x <= toX; x++)
+		{
+			if (is_solid_cell(x, y))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool CollisionGrid::is_solid_at(Vector2 position) const
+{
+	return is_solid_cell(cell_x(position.x), cell_y(position.y));
+}
+
+bool CollisionGrid::overlaps_solid(Rectangle rect) const
+{
+	return is_any_solid(cell_x(rect.x + Epsilon),
+						cell_y(rect.y + Epsilon),
+						cell_x(rect.x + rect.width - Epsilon),
+						cell_y(rect.y + rect.height - Epsilon));
+}
+
+bool CollisionGrid::is_on_ground(Rectangle rect, float distance) const
+{
+	float bottom = rect.y + rect.height;
+	return is_any_solid(cell_x(rect.x + Epsilon),
+						cell_y(bottom),
+						cell_x(rect.x + rect.width - Epsilon),
+						cell_y(bottom + distance - Epsilon));
+}
+
+bool CollisionGrid::is_against_wall(Rectangle rect, bool right, float distance) const
+{
+	float fromX = right ? rect.x + rect.width : rect.x - distance;
+	float toX = right ? rect.x + rect.width + distance : rect.x;
+	return is_any_solid(cell_x(fromX + Epsilon),
+						cell_y(rect.y + Epsilon),
+						cell_x(toX - Epsilon),
+						cell_y(rect.y + rect.height - Epsilon));
+}
+
+CollisionGrid::SweepResult CollisionGrid::sweep(Rectangle rect, Vector2 delta) const
+{
+	SweepResult result{.rect = rect};
+	auto &moved = result.rect;
+
+	if (delta.x != 0)
+	{
+		int rowFrom = cell_y(moved.y + Epsilon);
+		int rowTo = cell_y(moved.y + moved.height - Epsilon);
+
+		if (delta.x > 0)
+		{
+			// walk the columns the right edge passes through
+			int columnFrom = cell_x(moved.x + moved.width - Epsilon) + 1;
+			int columnTo = cell_x(moved.x + moved.width + delta.x - Epsilon);
+			moved.x += delta.x;
+
+			for (int column = columnFrom; column <= columnTo; column++)
+			{
+				if (is_any_solid(column, rowFrom, column, rowTo))
+				{
+					moved.x = origin.x + column * cellSize - moved.width;
+					result.hitX = true;
+					break;
+				}
+			}
+		}
+		else
+		{
+			int columnFrom = cell_x(moved.x + Epsilon) - 1;
+			int columnTo = cell_x(moved.x + delta.x + Epsilon);
+			moved.x += delta.x;
+
+			for (int column = columnFrom; column >= columnTo; column--)
+			{
+				if (is_any_solid(column, rowFrom, column, rowTo))
+				{
+					moved.x = origin.x + (column + 1) * cellSize;
+					result.hitX = true;
+					break;
+				}
+			}
+		}
+	}
+
+	if (delta.y != 0)
+	{
+		int columnFrom = cell_x(moved.x + Epsilon);
+		int columnTo = cell_x(moved.x + moved.width - Epsilon);
+
+		if (delta.y > 0)
+		{
+			int rowFrom = cell_y(moved.y + moved.height - Epsilon) + 1;
+			int rowTo = cell_y(moved.y + moved.height + delta.y - Epsilon);
+			moved.y += delta.y;
+
+			for (int row = rowFrom; row <= rowTo; row++)
+			{
+				if (is_any_solid(columnFrom, row, columnTo, row))
+				{
+					moved.y = origin.y + row * cellSize - moved.height;
+					result.hitY = true;
+					break;
+				}
+			}
+		}
+		else
+		{
+			int rowFrom = cell_y(moved.y + Epsilon) - 1;
+			int rowTo = cell_y(moved.y + delta.y + Epsilon);
+			moved.y += delta.y;
+
+			for (int row = rowFrom; row >= rowTo; row--)
+			{
+				if (is_any_solid(columnFrom, row, columnTo, row))
+				{
+					moved.y = origin.y + (row + 1) * cellSize;
+					result.hitY = true;
+					break;
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+int CollisionGrid::get_width() const
+{
+	return width;
+}
+
+int CollisionGrid::get_height() const
+{
+	return height;
+}
+
+int CollisionGrid::get_cell_size() const
+{
+	return cellSize;
+}
+
+Vector2 CollisionGrid::get_origin() const
+{
+	return origin;
+}
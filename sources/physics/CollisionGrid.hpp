@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+#include <LDtkLoader/Level.hpp>
+
+/**
+ * Bitset of the solid cells of a level, one bit per `GameConstants::CellSize`
+ * cell. Since all level geometry is grid aligned this can answer ground/wall
+ * checks and simple kinematic sweeps for entities that don't live in Box2D
+ * (projectiles, particles, simple enemies) without going through the Box2D
+ * broadphase.
+ *
+ * All positions and rectangles are in world pixels.
+ */
+class CollisionGrid
+{
+private:
+    int width = 0;
+    int height = 0;
+    int cellSize;
+    Vector2 origin{};
+
+    std::vector<uint64_t> bits;
+
+    int cell_x(float x) const;
+    int cell_y(float y) const;
+
+    // true if any cell in the inclusive cell range is solid
+    bool is_any_solid(int fromX, int fromY, int toX, int toY) const;
+
+public:
+    struct SweepResult
+    {
+        Rectangle rect;
+        bool hitX = false;
+        bool hitY = false;
+    };
+
+    CollisionGrid();
+    CollisionGrid(int width, int height, Vector2 origin = {0, 0});
+
+    // Marks every cell covered by an entity of the level's `PhysicsEntities` layer as solid
+    static CollisionGrid from_level(const ldtk::Level *level, Vector2 origin = {0, 0});
+
+    void set_solid(int x, int y, bool solid);
+
+    // Cells outside of the grid are never solid
+    bool is_solid_cell(int x, int y) const;
+    bool is_solid_at(Vector2 position) const;
+    bool overlaps_solid(Rectangle rect) const;
+
+    // Checks the strip of `distance` pixels right below/beside the rectangle
+    bool is_on_ground(Rectangle rect, float distance = 1.0f) const;
+    bool is_against_wall(Rectangle rect, bool right, float distance = 1.0f) const;
+
+    // Moves `rect` by `delta` one axis at a time (x first), stopping at the
+    // first solid cell on each axis
+    SweepResult sweep(Rectangle rect, Vector2 delta) const;
+
+    int get_width() const;
+    int get_height() const;
+    int get_cell_size() const;
+    Vector2 get_origin() const;
+};
@@ -0,0 +1,64 @@
+#include <box2d/box2d.h>
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+#include <utils/DebugUtils.hpp>
+
+#include "LevelColliders.hpp"
+#include "PhysicsTypes.hpp"
+
+namespace LevelColliders
+{
+	std::vector<b2Body *> create(const ldtk::Level *level, b2World *world, Vector2 offset, bool verbose)
+	{
+		std::vector<b2Body *> bodies;
+
+		if (verbose)
+		{
+			DebugUtils::println("Loading solid blocks in level:");
+		}
+
+		for (auto &&entity : level->getLayer("PhysicsEntities").allEntities())
+		{
+			// box2d width and height start from the center of the box
+			auto b2width = entity.getSize().x / 2.0f;
+			auto b2height = entity.getSize().y / 2.0f;
+
+			auto centerX = offset.x + entity.getPosition().x + b2width;
+			auto centerY = offset.y + entity.getPosition().y + b2height;
+
+			b2BodyDef bodyDef;
+			bodyDef.userData.pointer = (uintptr_t)PhysicsTypes::SolidBlock.data();
+			bodyDef.position.Set(centerX / GameConstants::PhysicsWorldScale,
+								 centerY / GameConstants::PhysicsWorldScale);
+
+			b2Body *body = world->CreateBody(&bodyDef);
+
+			b2PolygonShape groundBox;
+			groundBox.SetAsBox(b2width / GameConstants::PhysicsWorldScale,
+							   b2height / GameConstants::PhysicsWorldScale);
+
+			body->CreateFixture(&groundBox, 0.0f);
+			bodies.push_back(body);
+
+			if (verbose)
+			{
+				DebugUtils::println("  - x:{} y:{} width:{} height:{}",
+									centerX,
+									centerY,
+									b2width,
+									b2height);
+			}
+		}
+
+		return bodies;
+	}
+
+	void destroy(const std::vector<b2Body *> &bodies, b2World *world)
+	{
+		for (auto body : bodies)
+		{
+			world->DestroyBody(body);
+		}
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/Level.hpp>
+
+namespace LevelColliders
+{
+    /**
+     * Creates a static solid body for every entity in the level's
+     * `PhysicsEntities` layer.
+     *
+     * @param level the LDtk level to read the colliders from
+     * @param world the physics world the bodies are added to
+     * @param offset offset in pixels applied to every collider, used to place
+     * levels at their world-space position when streaming
+     * @param verbose whether to print every collider in debug builds, off
+     * when the level is created over and over (e.g. in benchmarks)
+     * @return the bodies that were created, so they can be destroyed later
+     */
+    std::vector<b2Body *> create(const ldtk::Level *level, b2World *world, Vector2 offset = {0, 0}, bool verbose = true);
+
+    void destroy(const std::vector<b2Body *> &bodies, b2World *world);
+}
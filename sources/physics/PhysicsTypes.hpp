@@ -1,9 +1,8 @@
 #pragma once
 
-#include <string>
-
-using namespace std;
+#include <string_view>
 
 namespace PhysicsTypes {
-    const string SolidBlock = "SOLID_BLOCK";
+    // Stored as box2d user data, literals are null terminated so `.data()` can be used as a C string
+    constexpr std::string_view SolidBlock = "SOLID_BLOCK";
 }
\ No newline at end of file
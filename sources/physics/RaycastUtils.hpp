@@ -1,9 +1,7 @@
 #pragma once
 
 #include <box2d/box2d.h>
-#include <string>
-
-using namespace std;
+#include <string_view>
 
 class RaysCastGetNearestCallback : public b2RayCastCallback
 {
@@ -27,14 +25,14 @@ public:
     float m_fraction;
 };
 
-b2Fixture *RaycastGetFirstFixtureFromSourceToTarget(b2World *world, b2Vec2 source, b2Vec2 target)
+inline b2Fixture *RaycastGetFirstFixtureFromSourceToTarget(b2World *world, b2Vec2 source, b2Vec2 target)
 {
     // query raylib to see if we're touching floor
     RaysCastGetNearestCallback raycastCallback;
 
-    GameScene::world->RayCast(&raycastCallback,
-                              source,
-                              target);
+    world->RayCast(&raycastCallback,
+                   source,
+                   target);
 
     return raycastCallback.m_fixture;
 }
@@ -50,7 +48,7 @@ b2Fixture *RaycastGetFirstFixtureFromSourceToTarget(b2World *world, b2Vec2 sourc
  * @return true
  * @return false
  */
-bool RaycastCheckCollisionWithUserData(b2World *world, b2Vec2 source, b2Vec2 target, string expected_user_data)
+inline bool RaycastCheckCollisionWithUserData(b2World *world, b2Vec2 source, b2Vec2 target, std::string_view expected_user_data)
 {
     auto fixture = RaycastGetFirstFixtureFromSourceToTarget(world, source, target);
     if (fixture)
@@ -59,8 +57,8 @@ bool RaycastCheckCollisionWithUserData(b2World *world, b2Vec2 source, b2Vec2 tar
 
         if (collision_body->GetUserData().pointer)
         {
-            string body_user_data = (char *)collision_body->GetUserData().pointer;
-            return body_user_data == expected_user_data;
+            // compare in place, building a string from the user data would allocate
+            return expected_user_data == (const char *)collision_body->GetUserData().pointer;
         }
     }
 
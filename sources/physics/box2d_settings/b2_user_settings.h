@@ -0,0 +1,66 @@
+#pragma once
+
+// Box2D user settings, only used when the project is configured with
+// `-DTRACK_ALLOCATIONS=ON` (see CMakeLists.txt). It mirrors the defaults from
+// box2d's b2_settings.h but routes b2Alloc/b2Free through the allocation
+// tracker so physics allocations show up in the per-frame counters.
+
+#include <stdarg.h>
+#include <stdint.h>
+
+#define b2_lengthUnitsPerMeter 1.0f
+#define b2_maxPolygonVertices 8
+
+struct B2_API b2BodyUserData
+{
+	b2BodyUserData()
+	{
+		pointer = 0;
+	}
+
+	uintptr_t pointer;
+};
+
+struct B2_API b2FixtureUserData
+{
+	b2FixtureUserData()
+	{
+		pointer = 0;
+	}
+
+	uintptr_t pointer;
+};
+
+struct B2_API b2JointUserData
+{
+	b2JointUserData()
+	{
+		pointer = 0;
+	}
+
+	uintptr_t pointer;
+};
+
+// Implemented in utils/AllocationTracker.cpp
+void *b2TrackedAlloc(int32 size);
+void b2TrackedFree(void *mem);
+
+inline void *b2Alloc(int32 size)
+{
+	return b2TrackedAlloc(size);
+}
+
+inline void b2Free(void *mem)
+{
+	b2TrackedFree(mem);
+}
+
+B2_API void b2Log_Default(const char *string, va_list args);
+
+inline void b2Log(const char *string, ...)
+{
+	va_list args;
+	va_start(args, string);
+	b2Log_Default(string, args);
+	va_end(args);
+}
@@ -0,0 +1,79 @@
+#include <raylib.h>
+
+#include "CachedUiLayer.hpp"
+#include "RenderTargetStack.hpp"
+
+CachedUiLayer::CachedUiLayer(int width, int height, Color clearColor)
+	: target(LoadRenderTexture(width, height)), clearColor(clearColor)
+{
+}
+
+CachedUiLayer::~CachedUiLayer()
+{
+	UnloadRenderTexture(target);
+}
+
+void CachedUiLayer::invalidate()
+{
+	dirty = true;
+}
+
+void CachedUiLayer::invalidate_on_input(std::span<const Rectangle> interactiveAreas)
+{
+	auto mouse = GetMousePosition();
+
+	bool mouseMoved = mouse.x != lastMousePosition.x || mouse.y != lastMousePosition.y;
+	if (mouseMoved)
+	{
+		// hover states change when the mouse enters, moves inside or leaves a control
+		for (auto &&area : interactiveAreas)
+		{
+			if (CheckCollisionPointRec(mouse, area) || CheckCollisionPointRec(lastMousePosition, area))
+			{
+				dirty = true;
+				break;
+			}
+		}
+	}
+	lastMousePosition = mouse;
+
+	for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_MIDDLE; button++)
+	{
+		if (IsMouseButtonDown(button) || IsMouseButtonReleased(button))
+		{
+			dirty = true;
+		}
+	}
+
+	if (GetMouseWheelMove() != 0.0f)
+	{
+		dirty = true;
+	}
+}
+
+void CachedUiLayer::begin_repaint()
+{
+	RenderTargetStack::push(target);
+	ClearBackground(clearColor);
+}
+
+void CachedUiLayer::end_repaint()
+{
+	RenderTargetStack::pop();
+	dirty = false;
+	repaintCount++;
+}
+
+void CachedUiLayer::draw(Vector2 position) const
+{
+	// render textures are stored upside down
+	DrawTextureRec(target.texture,
+				   {0, 0, (float)target.texture.width, (float)-target.texture.height},
+				   position,
+				   WHITE);
+}
+
+int CachedUiLayer::get_repaint_count() const
+{
+	return repaintCount;
+}
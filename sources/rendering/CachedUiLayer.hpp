@@ -0,0 +1,66 @@
+#pragma once
+
+#include <span>
+
+#include <raylib.h>
+
+/**
+ * Render texture holding an immediate-mode (raygui) UI that only gets drawn
+ * again when something could have changed it. raygui has no retained state
+ * to diff, so changes are inferred from input: any mouse button or wheel
+ * activity, and the mouse moving into, inside or out of one of the
+ * interactive areas. Everything else, including the mouse cursor, should be
+ * drawn on top of the cached layer every frame.
+ *
+ * Interaction is handled while the UI is drawn, so a control only reports
+ * clicks on frames where the layer is repainted, which are exactly the
+ * frames with input.
+ */
+class CachedUiLayer
+{
+private:
+    RenderTexture2D target;
+    Color clearColor;
+
+    bool dirty = true;
+    Vector2 lastMousePosition{-1, -1};
+    int repaintCount = 0;
+
+    void begin_repaint();
+    void end_repaint();
+
+public:
+    // The layer is opaque unless `clearColor` is BLANK, in which case
+    // translucent UI drawn into it won't blend exactly like on screen
+    CachedUiLayer(int width, int height, Color clearColor);
+    ~CachedUiLayer();
+
+    CachedUiLayer(const CachedUiLayer &) = delete;
+    CachedUiLayer &operator=(const CachedUiLayer &) = delete;
+
+    // Forces a repaint, for state changes that don't come from input
+    void invalidate();
+
+    // Marks the layer dirty if this frame's input may affect a control in
+    // `interactiveAreas` (in the same coordinates as GetMousePosition)
+    void invalidate_on_input(std::span<const Rectangle> interactiveAreas);
+
+    // Draws into the cache with `draw` if the layer is dirty, returns whether it did
+    template <typename DrawFunction>
+    bool repaint_if_needed(DrawFunction &&draw)
+    {
+        if (!dirty)
+        {
+            return false;
+        }
+
+        begin_repaint();
+        draw();
+        end_repaint();
+        return true;
+    }
+
+    void draw(Vector2 position = {0, 0}) const;
+
+    int get_repaint_count() const;
+};
@@ -0,0 +1,79 @@
+#include <algorithm>
+
+#include <raylib.h>
+
+#include "LabelAtlas.hpp"
+#include "RenderTargetStack.hpp"
+
+namespace
+{
+	constexpr int ShadowOffset = 1;
+
+	// keeps labels from sampling their neighbours
+	constexpr int Padding = 1;
+}
+
+LabelAtlas::~LabelAtlas()
+{
+	if (atlas.id != 0)
+	{
+		UnloadRenderTexture(atlas);
+	}
+}
+
+int LabelAtlas::add(const std::string &text, int fontSize, Color color, Color shadowColor)
+{
+	labels.push_back({
+		.text = text,
+		.fontSize = fontSize,
+		.color = color,
+		.shadowColor = shadowColor,
+	});
+	return (int)labels.size() - 1;
+}
+
+void LabelAtlas::build()
+{
+	if (atlas.id != 0)
+	{
+		UnloadRenderTexture(atlas);
+	}
+
+	// one label per row, menus only have a handful of them
+	int width = 1;
+	int height = 0;
+	for (auto &&label : labels)
+	{
+		float labelWidth = float(MeasureText(label.text.c_str(), label.fontSize) + ShadowOffset);
+		float labelHeight = float(label.fontSize + ShadowOffset);
+
+		label.source = {0, (float)height, labelWidth, labelHeight};
+		width = std::max(width, (int)labelWidth);
+		height += (int)labelHeight + Padding;
+	}
+
+	atlas = LoadRenderTexture(width, std::max(height, 1));
+
+	RenderTargetStack::push(atlas);
+	ClearBackground(BLANK);
+	for (auto &&label : labels)
+	{
+		int x = (int)label.source.x;
+		int y = (int)label.source.y;
+		DrawText(label.text.c_str(), x + ShadowOffset, y + ShadowOffset, label.fontSize, label.shadowColor);
+		DrawText(label.text.c_str(), x, y, label.fontSize, label.color);
+	}
+	RenderTargetStack::pop();
+}
+
+void LabelAtlas::draw(int label, Vector2 position) const
+{
+	const auto &source = labels[label].source;
+
+	// render textures are stored upside down
+	float flippedY = atlas.texture.height - source.y - source.height;
+	DrawTextureRec(atlas.texture,
+				   {source.x, flippedY, source.width, -source.height},
+				   position,
+				   WHITE);
+}
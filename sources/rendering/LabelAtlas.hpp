@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <raylib.h>
+
+/**
+ * Static text labels, each pre-rendered with its drop shadow into one shared
+ * texture. Drawing a label is then a single textured quad instead of one
+ * quad per glyph for the shadow and another for the text.
+ *
+ * Labels are added up-front and rendered together by `build`.
+ */
+class LabelAtlas
+{
+private:
+    struct Label
+    {
+        std::string text;
+        int fontSize;
+        Color color;
+        Color shadowColor;
+        Rectangle source;
+    };
+
+    std::vector<Label> labels;
+    RenderTexture2D atlas{};
+
+public:
+    LabelAtlas() = default;
+    ~LabelAtlas();
+
+    LabelAtlas(const LabelAtlas &) = delete;
+    LabelAtlas &operator=(const LabelAtlas &) = delete;
+
+    // Returns the id to draw the label with. The shadow is offset by one pixel
+    // down and to the right.
+    int add(const std::string &text, int fontSize, Color color, Color shadowColor);
+
+    // Renders every added label into the atlas texture
+    void build();
+
+    // `position` is the top-left corner of the text, like DrawText
+    void draw(int label, Vector2 position) const;
+};
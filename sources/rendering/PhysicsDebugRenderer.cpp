@@ -0,0 +1,343 @@
+#include <rlgl.h>
+
+#include <Constants.hpp>
+
+#include "PhysicsDebugRenderer.hpp"
+
+namespace
+{
+	constexpr int CircleSegments = 16;
+
+	// length of the axes drawn by DrawTransform, in meters
+	constexpr float TransformAxisLength = 0.4f;
+
+	// same palette as b2World::DebugDraw
+	const b2Color DisabledBodyColor{0.5f, 0.5f, 0.3f};
+	const b2Color StaticBodyColor{0.5f, 0.9f, 0.5f};
+	const b2Color KinematicBodyColor{0.5f, 0.5f, 0.9f};
+	const b2Color SleepingBodyColor{0.6f, 0.6f, 0.6f};
+	const b2Color AwakeBodyColor{0.9f, 0.7f, 0.7f};
+	const b2Color AabbColor{0.9f, 0.3f, 0.9f};
+	const b2Color ContactPointColor{0.9f, 0.3f, 0.3f};
+	const b2Color ContactNormalColor{0.9f, 0.9f, 0.3f};
+
+	Color to_color(const b2Color &color)
+	{
+		return {
+			static_cast<unsigned char>(color.r * 255.0f),
+			static_cast<unsigned char>(color.g * 255.0f),
+			static_cast<unsigned char>(color.b * 255.0f),
+			static_cast<unsigned char>(color.a * 255.0f),
+		};
+	}
+
+	const b2Color &get_body_color(b2Body *body)
+	{
+		if (!body->IsEnabled())
+		{
+			return DisabledBodyColor;
+		}
+		if (body->GetType() == b2_staticBody)
+		{
+			return StaticBodyColor;
+		}
+		if (body->GetType() == b2_kinematicBody)
+		{
+			return KinematicBodyColor;
+		}
+		if (!body->IsAwake())
+		{
+			return SleepingBodyColor;
+		}
+		return AwakeBodyColor;
+	}
+}
+
+PhysicsDebugRenderer::PhysicsDebugRenderer()
+{
+#ifdef DEBUG
+	enabled = true;
+#else
+	enabled = false;
+#endif
+
+	SetFlags(e_shapeBit | e_jointBit | e_pairBit | e_centerOfMassBit);
+}
+
+void PhysicsDebugRenderer::handle_input()
+{
+	if (IsKeyPressed(KEY_F1))
+	{
+		set_enabled(!enabled);
+	}
+
+	if (IsKeyPressed(KEY_F2))
+	{
+		SetFlags(GetFlags() ^ e_aabbBit);
+
+		// static bodies have AABBs too
+		invalidate();
+	}
+}
+
+void PhysicsDebugRenderer::set_enabled(bool enabled)
+{
+	this->enabled = enabled;
+}
+
+bool PhysicsDebugRenderer::is_enabled() const
+{
+	return enabled;
+}
+
+void PhysicsDebugRenderer::invalidate()
+{
+	staticCacheValid = false;
+}
+
+const PhysicsDebugRenderer::Stats &PhysicsDebugRenderer::get_stats() const
+{
+	return stats;
+}
+
+void PhysicsDebugRenderer::draw(b2World *world)
+{
+	if (!enabled || world == nullptr)
+	{
+		return;
+	}
+
+	if (!staticCacheValid)
+	{
+		staticVertices.clear();
+		target = &staticVertices;
+
+		for (auto body = world->GetBodyList(); body != nullptr; body = body->GetNext())
+		{
+			if (body->GetType() == b2_staticBody)
+			{
+				add_body(body);
+			}
+		}
+
+		staticCacheValid = true;
+		stats.cacheRebuilds++;
+	}
+
+	frameVertices.clear();
+	target = &frameVertices;
+
+	for (auto body = world->GetBodyList(); body != nullptr; body = body->GetNext())
+	{
+		if (body->GetType() != b2_staticBody)
+		{
+			add_body(body);
+		}
+	}
+
+	if (GetFlags() & e_jointBit)
+	{
+		for (auto joint = world->GetJointList(); joint != nullptr; joint = joint->GetNext())
+		{
+			joint->Draw(this);
+		}
+	}
+
+	if (GetFlags() & e_pairBit)
+	{
+		add_contacts(world);
+	}
+
+	stats.staticVertices = static_cast<int>(staticVertices.size());
+	stats.frameVertices = static_cast<int>(frameVertices.size());
+
+	// rlgl splits the batch by itself if it runs out of room
+	rlBegin(RL_LINES);
+	for (auto vertices : {&staticVertices, &frameVertices})
+	{
+		for (auto &&vertex : *vertices)
+		{
+			rlColor4ub(vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a);
+			rlVertex2f(vertex.x, vertex.y);
+		}
+	}
+	rlEnd();
+}
+
+void PhysicsDebugRenderer::add_line(const b2Vec2 &a, const b2Vec2 &b, const b2Color &color)
+{
+	auto rayColor = to_color(color);
+	target->push_back({a.x * GameConstants::PhysicsWorldScale, a.y * GameConstants::PhysicsWorldScale, rayColor});
+	target->push_back({b.x * GameConstants::PhysicsWorldScale, b.y * GameConstants::PhysicsWorldScale, rayColor});
+}
+
+void PhysicsDebugRenderer::add_body(b2Body *body)
+{
+	auto &transform = body->GetTransform();
+
+	if (GetFlags() & e_shapeBit)
+	{
+		auto &color = get_body_color(body);
+		for (auto fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext())
+		{
+			add_shape(fixture, transform, color);
+		}
+	}
+
+	// disabled bodies have no broad-phase proxies, so no AABBs either
+	if ((GetFlags() & e_aabbBit) && body->IsEnabled())
+	{
+		for (auto fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext())
+		{
+			for (int32 child = 0; child < fixture->GetShape()->GetChildCount(); child++)
+			{
+				auto &aabb = fixture->GetAABB(child);
+				b2Vec2 vertices[4] = {
+					aabb.lowerBound,
+					{aabb.upperBound.x, aabb.lowerBound.y},
+					aabb.upperBound,
+					{aabb.lowerBound.x, aabb.upperBound.y},
+				};
+				DrawPolygon(vertices, 4, AabbColor);
+			}
+		}
+	}
+
+	if (GetFlags() & e_centerOfMassBit)
+	{
+		b2Transform center = transform;
+		center.p = body->GetWorldCenter();
+		DrawTransform(center);
+	}
+}
+
+void PhysicsDebugRenderer::add_shape(b2Fixture *fixture, const b2Transform &transform, const b2Color &color)
+{
+	switch (fixture->GetType())
+	{
+	case b2Shape::e_circle:
+	{
+		auto circle = static_cast<b2CircleShape *>(fixture->GetShape());
+		auto center = b2Mul(transform, circle->m_p);
+		auto axis = b2Mul(transform.q, b2Vec2(1.0f, 0.0f));
+		DrawSolidCircle(center, circle->m_radius, axis, color);
+		break;
+	}
+
+	case b2Shape::e_edge:
+	{
+		auto edge = static_cast<b2EdgeShape *>(fixture->GetShape());
+		auto v1 = b2Mul(transform, edge->m_vertex1);
+		auto v2 = b2Mul(transform, edge->m_vertex2);
+		DrawSegment(v1, v2, color);
+
+		if (!edge->m_oneSided)
+		{
+			DrawPoint(v1, 4.0f, color);
+			DrawPoint(v2, 4.0f, color);
+		}
+		break;
+	}
+
+	case b2Shape::e_chain:
+	{
+		auto chain = static_cast<b2ChainShape *>(fixture->GetShape());
+		auto previous = b2Mul(transform, chain->m_vertices[0]);
+		for (int32 i = 1; i < chain->m_count; i++)
+		{
+			auto current = b2Mul(transform, chain->m_vertices[i]);
+			DrawSegment(previous, current, color);
+			previous = current;
+		}
+		break;
+	}
+
+	case b2Shape::e_polygon:
+	{
+		auto polygon = static_cast<b2PolygonShape *>(fixture->GetShape());
+		b2Vec2 vertices[b2_maxPolygonVertices];
+		for (int32 i = 0; i < polygon->m_count; i++)
+		{
+			vertices[i] = b2Mul(transform, polygon->m_vertices[i]);
+		}
+		DrawSolidPolygon(vertices, polygon->m_count, color);
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+void PhysicsDebugRenderer::add_contacts(b2World *world)
+{
+	for (auto contact = world->GetContactList(); contact != nullptr; contact = contact->GetNext())
+	{
+		if (!contact->IsTouching())
+		{
+			continue;
+		}
+
+		b2WorldManifold manifold;
+		contact->GetWorldManifold(&manifold);
+
+		for (int32 i = 0; i < contact->GetManifold()->pointCount; i++)
+		{
+			auto &point = manifold.points[i];
+			DrawPoint(point, 4.0f, ContactPointColor);
+			DrawSegment(point, point + 0.5f * manifold.normal, ContactNormalColor);
+		}
+	}
+}
+
+void PhysicsDebugRenderer::DrawPolygon(const b2Vec2 *vertices, int32 vertexCount, const b2Color &color)
+{
+	for (int32 i = 0; i < vertexCount; i++)
+	{
+		add_line(vertices[i], vertices[(i + 1) % vertexCount], color);
+	}
+}
+
+void PhysicsDebugRenderer::DrawSolidPolygon(const b2Vec2 *vertices, int32 vertexCount, const b2Color &color)
+{
+	// outlines only, filled shapes would hide the level underneath
+	DrawPolygon(vertices, vertexCount, color);
+}
+
+void PhysicsDebugRenderer::DrawCircle(const b2Vec2 &center, float radius, const b2Color &color)
+{
+	constexpr float step = 2.0f * b2_pi / CircleSegments;
+
+	b2Vec2 previous = center + b2Vec2(radius, 0.0f);
+	for (int i = 1; i <= CircleSegments; i++)
+	{
+		b2Vec2 current = center + radius * b2Vec2(cosf(step * i), sinf(step * i));
+		add_line(previous, current, color);
+		previous = current;
+	}
+}
+
+void PhysicsDebugRenderer::DrawSolidCircle(const b2Vec2 &center, float radius, const b2Vec2 &axis, const b2Color &color)
+{
+	DrawCircle(center, radius, color);
+	add_line(center, center + radius * axis, color);
+}
+
+void PhysicsDebugRenderer::DrawSegment(const b2Vec2 &p1, const b2Vec2 &p2, const b2Color &color)
+{
+	add_line(p1, p2, color);
+}
+
+void PhysicsDebugRenderer::DrawTransform(const b2Transform &xf)
+{
+	add_line(xf.p, xf.p + TransformAxisLength * xf.q.GetXAxis(), {1.0f, 0.0f, 0.0f});
+	add_line(xf.p, xf.p + TransformAxisLength * xf.q.GetYAxis(), {0.0f, 1.0f, 0.0f});
+}
+
+void PhysicsDebugRenderer::DrawPoint(const b2Vec2 &p, float size, const b2Color &color)
+{
+	// `size` is in pixels, drawn as a small cross
+	float halfSize = size * 0.5f / GameConstants::PhysicsWorldScale;
+	add_line(p - b2Vec2(halfSize, 0.0f), p + b2Vec2(halfSize, 0.0f), color);
+	add_line(p - b2Vec2(0.0f, halfSize), p + b2Vec2(0.0f, halfSize), color);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+
+/**
+ * Draws a Box2D world for debugging: every shape type, AABBs, contacts,
+ * joints and centers of mass, picked with the usual b2Draw flags.
+ *
+ * Everything is collected as line vertices and submitted in one RL_LINES
+ * batch. Static bodies are turned into lines once and reused on every frame
+ * until `invalidate` is called, which whoever adds, removes or moves static
+ * bodies (or switches worlds) has to do.
+ *
+ * Works in release builds too, F1 toggles it at runtime and F2 toggles AABBs.
+ */
+class PhysicsDebugRenderer : public b2Draw
+{
+public:
+    struct Stats
+    {
+        int staticVertices = 0;
+        int frameVertices = 0;
+        int cacheRebuilds = 0;
+    };
+
+private:
+    struct LineVertex
+    {
+        float x;
+        float y;
+        Color color;
+    };
+
+    bool enabled;
+
+    std::vector<LineVertex> staticVertices;
+    std::vector<LineVertex> frameVertices;
+
+    // where the b2Draw callbacks currently add their lines
+    std::vector<LineVertex> *target = &frameVertices;
+
+    bool staticCacheValid = false;
+
+    Stats stats;
+
+    void add_line(const b2Vec2 &a, const b2Vec2 &b, const b2Color &color);
+    void add_body(b2Body *body);
+    void add_shape(b2Fixture *fixture, const b2Transform &transform, const b2Color &color);
+    void add_contacts(b2World *world);
+
+public:
+    PhysicsDebugRenderer();
+
+    // F1 toggles drawing, F2 toggles AABBs
+    void handle_input();
+
+    void set_enabled(bool enabled);
+    bool is_enabled() const;
+
+    // Draws in world pixels, so it goes inside the camera's transform (if any)
+    void draw(b2World *world);
+
+    // Rebuilds the static lines on the next draw. GameScene calls it when a
+    // level is loaded or streamed in or out. Simulation::load_state rebuilds
+    // the same level, so rollbacks don't need it.
+    void invalidate();
+
+    const Stats &get_stats() const;
+
+    void DrawPolygon(const b2Vec2 *vertices, int32 vertexCount, const b2Color &color) override;
+    void DrawSolidPolygon(const b2Vec2 *vertices, int32 vertexCount, const b2Color &color) override;
+    void DrawCircle(const b2Vec2 &center, float radius, const b2Color &color) override;
+    void DrawSolidCircle(const b2Vec2 &center, float radius, const b2Vec2 &axis, const b2Color &color) override;
+    void DrawSegment(const b2Vec2 &p1, const b2Vec2 &p2, const b2Color &color) override;
+    void DrawTransform(const b2Transform &xf) override;
+    void DrawPoint(const b2Vec2 &p, float size, const b2Color &color) override;
+};
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory>
+
+#include <raylib.h>
+
+#include <Constants.hpp>
+
+#include "QualityGovernor.hpp"
+
+namespace
+{
+	// highest first, every step gives up a little more
+	constexpr std::array<QualityLevel, 4> Levels = {{
+		{"high", 1.0f, 1.0f, true, true},
+		// post effects go first, they cost the most for what they add
+		{"medium", 1.0f, 0.5f, false, true},
+		{"low", 0.75f, 0.5f, false, false},
+		{"lowest", 0.5f, 0.25f, false, false},
+	}};
+
+	// both aim for one refresh, see get_refresh_budget_ms
+	constexpr QualityProfile DesktopProfile = {"desktop", 0.0f, 0};
+
+	// the page and the browser share the GPU with the game, so don't start
+	// at the top
+	constexpr QualityProfile WebProfile = {"web", 0.0f, 1};
+
+	struct GovernorState
+	{
+		UpscalePipeline *pipeline;
+		QualityProfile profile;
+
+		// median frame interval above which quality goes down
+		float targetMs = 0;
+
+		// the config picked on the command line, what the highest level shows
+		UpscaleConfig baseConfig;
+
+		bool fixed = false;
+		int level = 0;
+
+		std::array<float, QualityConstants::WindowFrames> window{};
+		int windowFrames = 0;
+		int frame = 0;
+
+		int windowsSinceChange = 0;
+		int upgradeDelay = QualityConstants::UpgradeDelayWindows;
+		bool lastChangeWasUpgrade = false;
+
+		int changes = 0;
+		std::array<int, Levels.size()> windowsAtLevel{};
+
+		FILE *trace = nullptr;
+	};
+
+	std::unique_ptr<GovernorState> governor;
+
+	void apply_level(int level)
+	{
+		const auto &quality = Levels[level];
+		governor->level = level;
+
+		auto config = governor->baseConfig;
+		config.resolutionScale *= quality.resolutionScale;
+		if (!quality.postEffects)
+		{
+			config.postEffects.clear();
+		}
+		governor->pipeline->set_config(config);
+	}
+
+	// one frame at the rate the game runs at, a slower monitor can't show more
+	float get_refresh_budget_ms()
+	{
+		int refreshRate = AppConstants::TargetFps;
+
+		// 0 when raylib can't tell, e.g. in browsers
+		int monitorRate = GetMonitorRefreshRate(GetCurrentMonitor());
+		if (monitorRate > 0)
+		{
+			refreshRate = std::min(refreshRate, monitorRate);
+		}
+
+		return 1000.0f / refreshRate;
+	}
+
+	void trace_decision(const char *decision, int from, float medianMs)
+	{
+		if (governor->trace == nullptr)
+		{
+			return;
+		}
+
+		std::fprintf(governor->trace,
+					 "{\"frame\": %d, \"profile\": \"%s\", \"median_ms\": %.3f, \"target_ms\": %.3f, "
+					 "\"decision\": \"%s\", \"from\": \"%s\", \"to\": \"%s\", \"upgrade_delay\": %d}\n",
+					 governor->frame,
+					 governor->profile.name,
+					 medianMs,
+					 governor->targetMs,
+					 decision,
+					 Levels[from].name,
+					 Levels[governor->level].name,
+					 governor->upgradeDelay);
+	}
+}
+
+namespace QualityGovernor
+{
+	void init(UpscalePipeline *pipeline, const QualityProfile &profile, int fixedLevel, const std::string &tracePath)
+	{
+		if (governor != nullptr)
+		{
+			return;
+		}
+
+		governor = std::make_unique<GovernorState>();
+		governor->pipeline = pipeline;
+		governor->profile = profile;
+		governor->baseConfig = pipeline->get_config();
+		governor->targetMs = profile.targetFrameMs > 0
+								 ? profile.targetFrameMs
+								 : get_refresh_budget_ms() * (1.0f + QualityConstants::FrameBudgetTolerance);
+		governor->fixed = fixedLevel >= 0;
+
+		if (!tracePath.empty())
+		{
+			governor->trace = std::fopen(tracePath.c_str(), "w");
+			if (governor->trace == nullptr)
+			{
+				TraceLog(LOG_WARNING, "Couldn't open %s for writing, quality decisions won't be traced", tracePath.c_str());
+			}
+		}
+
+		int startLevel = governor->fixed ? fixedLevel : profile.startLevel;
+		apply_level(std::clamp(startLevel, 0, (int)Levels.size() - 1));
+
+		TraceLog(LOG_INFO,
+				 "Quality: %s profile, target %.1f ms, %s at %s",
+				 profile.name,
+				 governor->targetMs,
+				 governor->fixed ? "fixed" : "starting",
+				 Levels[governor->level].name);
+	}
+
+	void shutdown()
+	{
+		if (governor == nullptr)
+		{
+			return;
+		}
+
+		TraceLog(LOG_INFO,
+				 "Quality: %d changes, %d frame windows at high %d, medium %d, low %d, lowest %d",
+				 governor->changes,
+				 QualityConstants::WindowFrames,
+				 governor->windowsAtLevel[0],
+				 governor->windowsAtLevel[1],
+				 governor->windowsAtLevel[2],
+				 governor->windowsAtLevel[3]);
+
+		if (governor->trace != nullptr)
+		{
+			std::fclose(governor->trace);
+		}
+
+		// the pipeline may outlive the governor, leave it as it was asked for
+		governor->pipeline->set_config(governor->baseConfig);
+		governor.reset();
+	}
+
+	void record_frame(float frameMs)
+	{
+		if (governor == nullptr)
+		{
+			return;
+		}
+
+		governor->frame++;
+		governor->window[governor->windowFrames++] = frameMs;
+		if (governor->windowFrames < QualityConstants::WindowFrames)
+		{
+			return;
+		}
+		governor->windowFrames = 0;
+
+		// sorting in place is fine, the window is refilled from the start
+		auto middle = governor->window.begin() + QualityConstants::WindowFrames / 2;
+		std::nth_element(governor->window.begin(), middle, governor->window.end());
+		float medianMs = *middle;
+
+		governor->windowsSinceChange++;
+		governor->windowsAtLevel[governor->level]++;
+
+		const int from = governor->level;
+		const int lowest = (int)Levels.size() - 1;
+		const float targetMs = governor->targetMs;
+		const char *decision = governor->fixed ? "fixed" : "hold";
+
+		if (!governor->fixed && medianMs > targetMs && from < lowest)
+		{
+			// the level above didn't even hold for one window, so it's only
+			// tried again after waiting twice as long
+			if (governor->lastChangeWasUpgrade && governor->windowsSinceChange <= 1)
+			{
+				governor->upgradeDelay = std::min(governor->upgradeDelay * 2, QualityConstants::MaxUpgradeDelayWindows);
+			}
+
+			apply_level(from + 1);
+			governor->lastChangeWasUpgrade = false;
+			decision = "down";
+		}
+		else if (!governor->fixed && medianMs <= targetMs && from > 0 &&
+				 governor->windowsSinceChange >= governor->upgradeDelay)
+		{
+			// frames wait for the next refresh, so being within the target
+			// doesn't tell how much room there is. The level above is tried,
+			// and if the next window misses the target it's taken back.
+			apply_level(from - 1);
+			governor->lastChangeWasUpgrade = true;
+			decision = "up";
+		}
+		else if (governor->lastChangeWasUpgrade && governor->windowsSinceChange >= QualityConstants::MaxUpgradeDelayWindows)
+		{
+			// the last upgrade has held for a long time, the game got faster
+			governor->upgradeDelay = QualityConstants::UpgradeDelayWindows;
+		}
+
+		if (governor->level != from)
+		{
+			governor->changes++;
+			governor->windowsSinceChange = 0;
+
+			TraceLog(LOG_INFO,
+					 "Quality: %s -> %s, median frame %.2f ms, target %.2f ms",
+					 Levels[from].name,
+					 Levels[governor->level].name,
+					 medianMs,
+					 targetMs);
+		}
+
+		trace_decision(decision, from, medianMs);
+	}
+
+	const QualityLevel &get_level()
+	{
+		return Levels[governor != nullptr ? governor->level : 0];
+	}
+
+	int get_level_index()
+	{
+		return governor != nullptr ? governor->level : 0;
+	}
+
+	int find_level(std::string_view name)
+	{
+		for (int i = 0; i < (int)Levels.size(); i++)
+		{
+			if (name == Levels[i].name)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	QualityProfile get_platform_profile()
+	{
+#if defined(PLATFORM_WEB)
+		return WebProfile;
+#else
+		return DesktopProfile;
+#endif
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "UpscalePipeline.hpp"
+
+// One step of the quality ladder, see QualityGovernor
+struct QualityLevel
+{
+    const char *name;
+
+    // UpscaleConfig::resolutionScale
+    float resolutionScale;
+
+    // Fraction of every particle emitter's capacity that may be alive
+    float particleFraction;
+
+    // Whether the post effects picked on the command line run
+    bool postEffects;
+
+    // Physics debug lines and the like
+    bool debugOverlays;
+};
+
+// Where the governor aims on one kind of platform
+struct QualityProfile
+{
+    const char *name;
+
+    // Time from one frame to the next (update, draw and waiting for the next
+    // refresh) the median frame shouldn't go over, 0 means one refresh at
+    // AppConstants::TargetFps or the monitor's rate if that's lower, plus
+    // QualityConstants::FrameBudgetTolerance
+    float targetFrameMs;
+
+    // Level the game starts at, 0 is the highest
+    int startLevel;
+};
+
+/**
+ * Holds the frame rate at the display's refresh by stepping the game's
+ * resolution, post effects, particle caps and debug overlays down when
+ * frames get too slow and back up when there is room again.
+ *
+ * It goes by the whole interval between frames, GPU work the driver only
+ * finishes while waiting for the swap included, since that is what the
+ * player sees. Frames are looked at in windows of
+ * QualityConstants::WindowFrames. Quality goes down by one level when a
+ * window's median is over the target, and the level above is tried again
+ * once enough windows stayed within it. An upgrade that the next window takes
+ * back doubles that wait, which keeps it from flipping between two levels.
+ *
+ * Every window's decision goes to the trace file (one JSON object per line)
+ * so profiles can be tuned from real runs, changes are logged too.
+ *
+ * Calls made before `init` (the benchmarks never call it) do nothing and the
+ * level stays the highest one.
+ */
+namespace QualityGovernor
+{
+    // `fixedLevel` >= 0 pins the quality to that level, the frames are
+    // still traced
+    void init(UpscalePipeline *pipeline,
+              const QualityProfile &profile,
+              int fixedLevel = -1,
+              const std::string &tracePath = {});
+    void shutdown();
+
+    // Once per frame after EndDrawing, with the time since the last frame
+    // (GetFrameTime)
+    void record_frame(float frameMs);
+
+    const QualityLevel &get_level();
+    int get_level_index();
+
+    // Index of the level with that name, -1 if there is none
+    int find_level(std::string_view name);
+
+    // Profile of the platform the game was built for
+    QualityProfile get_platform_profile();
+}
@@ -0,0 +1,95 @@
+#include <array>
+
+#include <raylib.h>
+#include <rlgl.h>
+
+#include "RenderTargetStack.hpp"
+
+namespace
+{
+	// deep enough for the game texture, a scene's cache and one more level
+	constexpr int MaxDepth = 8;
+
+	struct Entry
+	{
+		RenderTexture2D target;
+
+		// size the target is drawn to as
+		float width;
+		float height;
+	};
+
+	std::array<Entry, MaxDepth> targets;
+	int depth = 0;
+
+	void begin(const Entry &entry)
+	{
+		BeginTextureMode(entry.target);
+
+		// BeginTextureMode maps one unit to one pixel of the target, stretch
+		// the projection so the whole logical size fits instead
+		if (entry.width != entry.target.texture.width || entry.height != entry.target.texture.height)
+		{
+			rlMatrixMode(RL_PROJECTION);
+			rlLoadIdentity();
+			rlOrtho(0, entry.width, entry.height, 0, 0.0, 1.0);
+			rlMatrixMode(RL_MODELVIEW);
+			rlLoadIdentity();
+		}
+	}
+}
+
+void RenderTargetStack::push(const RenderTexture2D &target)
+{
+	push(target, (float)target.texture.width, (float)target.texture.height);
+}
+
+void RenderTargetStack::push(const RenderTexture2D &target, float width, float height)
+{
+	if (depth == MaxDepth)
+	{
+		TraceLog(LOG_ERROR, "Render targets nested more than %d deep", MaxDepth);
+		return;
+	}
+
+	targets[depth] = {target, width, height};
+	begin(targets[depth++]);
+}
+
+void RenderTargetStack::pop()
+{
+	if (depth == 0)
+	{
+		TraceLog(LOG_ERROR, "Popped a render target that was never pushed");
+		return;
+	}
+
+	EndTextureMode();
+	depth--;
+
+	if (depth > 0)
+	{
+		begin(targets[depth - 1]);
+	}
+}
+
+Vector2 RenderTargetStack::get_pixel_size()
+{
+	if (depth == 0)
+	{
+		return {(float)GetRenderWidth(), (float)GetRenderHeight()};
+	}
+
+	auto &texture = targets[depth - 1].target.texture;
+	return {(float)texture.width, (float)texture.height};
+}
+
+Vector2 RenderTargetStack::get_logical_size()
+{
+	if (depth == 0)
+	{
+		return {(float)GetScreenWidth(), (float)GetScreenHeight()};
+	}
+
+	return {targets[depth - 1].width, targets[depth - 1].height};
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <raylib.h>
+
+/**
+ * BeginTextureMode/EndTextureMode that can be nested. raylib's EndTextureMode
+ * always goes back to drawing on the screen, so a scene that renders into its
+ * own texture while the frame is being drawn into the game render texture
+ * would send everything after it to the screen. `pop` goes back to the target
+ * that was active before the matching `push` instead.
+ *
+ * A target can also be drawn to as if it was `width`x`height` pixels, no
+ * matter its actual size. That's how the game is drawn at a lower resolution
+ * without any scene knowing about it.
+ */
+namespace RenderTargetStack
+{
+    void push(const RenderTexture2D &target);
+    void push(const RenderTexture2D &target, float width, float height);
+    void pop();
+
+    // Size in pixels of the target being drawn to, the screen's if none is
+    Vector2 get_pixel_size();
+
+    // Size the target being drawn to is drawn to as, see `push`
+    Vector2 get_logical_size();
+}
@@ -0,0 +1,253 @@
+#include <raylib.h>
+#include <rlgl.h>
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+#include <utils/AssetRegistry.hpp>
+#include <utils/CookedTexture.hpp>
+#include <utils/DebugUtils.hpp>
+
+#include "TileLayerRenderer.hpp"
+
+TileLayerRenderer::TileLayerRenderer()
+{
+	shader = LoadShader(nullptr, AssetRegistry::get_path(AssetId::TILEMAP_SHADER));
+
+	if (is_supported())
+	{
+		tilesetLoc = GetShaderLocation(shader, "tileset");
+		tilesetSizeLoc = GetShaderLocation(shader, "tilesetSize");
+		gridSizeLoc = GetShaderLocation(shader, "gridSize");
+		tileSizeLoc = GetShaderLocation(shader, "tileSize");
+		tileSpacingLoc = GetShaderLocation(shader, "tileSpacing");
+		tilePaddingLoc = GetShaderLocation(shader, "tilePadding");
+	}
+}
+
+TileLayerRenderer::~TileLayerRenderer()
+{
+	unload();
+	UnloadShader(shader);
+}
+
+bool TileLayerRenderer::is_supported() const
+{
+	// a missing or broken shader file gets raylib's default shader, which
+	// IsShaderValid happily accepts
+	return IsShaderValid(shader) && shader.id != rlGetShaderIdDefault();
+}
+
+bool TileLayerRenderer::load_level(const ldtk::Level *level)
+{
+	unload();
+
+	// LDtk lists layers top-most first, we want to draw bottom-most first
+	const auto &allLayers = level->allLayers();
+	for (auto it = allLayers.rbegin(); it != allLayers.rend(); ++it)
+	{
+		auto &&ldtkLayer = *it;
+		if (!ldtkLayer.hasTileset())
+		{
+			continue;
+		}
+
+		const auto &tileset = ldtkLayer.getTileset();
+		const int stride = tileset.tile_size + tileset.spacing;
+
+		Layer layer;
+		layer.tilesetColumns = (tileset.texture_size.x - 2 * tileset.padding + tileset.spacing) / stride;
+		layer.tilesetRows = (tileset.texture_size.y - 2 * tileset.padding + tileset.spacing) / stride;
+
+		if (layer.tilesetColumns > MaxTilesetCells || layer.tilesetRows > MaxTilesetCells)
+		{
+			TraceLog(LOG_ERROR,
+					 "Tileset '%s' of layer '%s' is %dx%d tiles, GPU tile layers can't address more than %dx%d",
+					 tileset.path.c_str(),
+					 ldtkLayer.getName().c_str(),
+					 layer.tilesetColumns,
+					 layer.tilesetRows,
+					 MaxTilesetCells,
+					 MaxTilesetCells);
+			unload();
+			return false;
+		}
+
+		layer.tileset = CookedTexture::load_asset_texture(tileset.path);
+		layer.tileSize = tileset.tile_size;
+		layer.spacing = tileset.spacing;
+		layer.padding = tileset.padding;
+		layer.cellSize = ldtkLayer.getCellSize();
+		layer.gridWidth = ldtkLayer.getGridSize().x;
+		layer.gridHeight = ldtkLayer.getGridSize().y;
+		layer.offset = {(float)ldtkLayer.getOffset().x, (float)ldtkLayer.getOffset().y};
+
+		for (auto &&tile : ldtkLayer.allTiles())
+		{
+			auto position = tile.getPosition();
+			auto textureRect = tile.getTextureRect();
+
+			int gridX = position.x / layer.cellSize;
+			int gridY = position.y / layer.cellSize;
+			int cellIndex = gridY * layer.gridWidth + gridX;
+
+			auto &indexTexture = get_free_index_texture(layer, cellIndex);
+			indexTexture.cells[cellIndex] = {
+				.r = (unsigned char)((textureRect.x - layer.padding) / stride),
+				.g = (unsigned char)((textureRect.y - layer.padding) / stride),
+				.b = (unsigned char)((tile.flipX ? FLIP_X : FLIP_NONE) | (tile.flipY ? FLIP_Y : FLIP_NONE)),
+				.a = 255,
+			};
+		}
+
+		for (auto &&indexTexture : layer.indexTextures)
+		{
+			Image image = {
+				.data = indexTexture.cells.data(),
+				.width = layer.gridWidth,
+				.height = layer.gridHeight,
+				.mipmaps = 1,
+				.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+			};
+
+			indexTexture.texture = LoadTextureFromImage(image);
+			SetTextureFilter(indexTexture.texture, TEXTURE_FILTER_POINT);
+		}
+
+		DebugUtils::println("GPU tile layer '{}' is {}x{} cells and uses {} index texture(s)",
+							ldtkLayer.getName(),
+							layer.gridWidth,
+							layer.gridHeight,
+							layer.indexTextures.size());
+
+		layers.push_back(std::move(layer));
+	}
+
+	return true;
+}
+
+void TileLayerRenderer::unload()
+{
+	for (auto &&layer : layers)
+	{
+		for (auto &&indexTexture : layer.indexTextures)
+		{
+			UnloadTexture(indexTexture.texture);
+		}
+
+		UnloadTexture(layer.tileset);
+	}
+
+	layers.clear();
+}
+
+TileLayerRenderer::IndexTexture &TileLayerRenderer::get_free_index_texture(Layer &layer, int cellIndex)
+{
+	for (auto &&indexTexture : layer.indexTextures)
+	{
+		if (indexTexture.cells[cellIndex].a == 0)
+		{
+			return indexTexture;
+		}
+	}
+
+	auto &indexTexture = layer.indexTextures.emplace_back();
+	indexTexture.cells.resize(layer.gridWidth * layer.gridHeight, BLANK);
+	return indexTexture;
+}
+
+void TileLayerRenderer::set_tile(size_t layerIndex, int gridX, int gridY, int tilesetColumn, int tilesetRow, uint8_t flips)
+{
+	auto &layer = layers[layerIndex];
+	if (layer.indexTextures.empty())
+	{
+		return;
+	}
+
+	if (tilesetColumn < 0 || tilesetRow < 0 || tilesetColumn >= layer.tilesetColumns || tilesetRow >= layer.tilesetRows)
+	{
+		TraceLog(LOG_ERROR, "Tile %d,%d is outside of the layer's %dx%d tileset", tilesetColumn, tilesetRow, layer.tilesetColumns, layer.tilesetRows);
+		return;
+	}
+
+	// the edited tile replaces the whole stack of the cell, so the tiles
+	// auto-layers stacked on top don't keep covering it
+	clear_tile(layerIndex, gridX, gridY);
+
+	auto &indexTexture = layer.indexTextures.front();
+	auto &cell = indexTexture.cells[gridY * layer.gridWidth + gridX];
+	cell = {
+		.r = (unsigned char)tilesetColumn,
+		.g = (unsigned char)tilesetRow,
+		.b = flips,
+		.a = 255,
+	};
+
+	UpdateTextureRec(indexTexture.texture, {(float)gridX, (float)gridY, 1, 1}, &cell);
+}
+
+void TileLayerRenderer::clear_tile(size_t layerIndex, int gridX, int gridY)
+{
+	auto &layer = layers[layerIndex];
+	const int cellIndex = gridY * layer.gridWidth + gridX;
+
+	for (auto &&indexTexture : layer.indexTextures)
+	{
+		auto &cell = indexTexture.cells[cellIndex];
+		if (cell.a == 0)
+		{
+			continue;
+		}
+
+		cell = BLANK;
+		UpdateTextureRec(indexTexture.texture, {(float)gridX, (float)gridY, 1, 1}, &cell);
+	}
+}
+
+size_t TileLayerRenderer::layer_count() const
+{
+	return layers.size();
+}
+
+void TileLayerRenderer::draw() const
+{
+	BeginShaderMode(shader);
+
+	for (auto &&layer : layers)
+	{
+		// uniforms apply to whatever is still batched, so flush the previous layer first
+		rlDrawRenderBatchActive();
+
+		const float tilesetSize[2] = {(float)layer.tileset.width, (float)layer.tileset.height};
+		const float gridSize[2] = {(float)layer.gridWidth, (float)layer.gridHeight};
+		const float tileSize = (float)layer.tileSize;
+		const float tileSpacing = (float)layer.spacing;
+		const float tilePadding = (float)layer.padding;
+
+		SetShaderValueTexture(shader, tilesetLoc, layer.tileset);
+		SetShaderValue(shader, tilesetSizeLoc, tilesetSize, SHADER_UNIFORM_VEC2);
+		SetShaderValue(shader, gridSizeLoc, gridSize, SHADER_UNIFORM_VEC2);
+		SetShaderValue(shader, tileSizeLoc, &tileSize, SHADER_UNIFORM_FLOAT);
+		SetShaderValue(shader, tileSpacingLoc, &tileSpacing, SHADER_UNIFORM_FLOAT);
+		SetShaderValue(shader, tilePaddingLoc, &tilePadding, SHADER_UNIFORM_FLOAT);
+
+		const Rectangle destination = {
+			layer.offset.x,
+			layer.offset.y,
+			(float)(layer.gridWidth * layer.cellSize),
+			(float)(layer.gridHeight * layer.cellSize),
+		};
+
+		for (auto &&indexTexture : layer.indexTextures)
+		{
+			DrawTexturePro(indexTexture.texture,
+						   {0, 0, (float)layer.gridWidth, (float)layer.gridHeight},
+						   destination,
+						   {0, 0},
+						   0.0f,
+						   WHITE);
+		}
+	}
+
+	rlDrawRenderBatchActive();
+	EndShaderMode();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+#include <LDtkLoader/Level.hpp>
+
+/**
+ * Renders the tile layers of an LDtk level on the GPU. Each layer is uploaded
+ * as a small "index" texture with one texel per cell (tileset column/row +
+ * flip bits) and then drawn as a single quad with a fragment shader that looks
+ * up the tileset. Changing a tile only touches one texel, so animated or
+ * destructible tiles don't require re-baking the level.
+ */
+class TileLayerRenderer
+{
+public:
+    // Column and row are stored in 8 bit channels
+    static constexpr int MaxTilesetCells = 256;
+
+    enum TileFlip : uint8_t
+    {
+        FLIP_NONE = 0,
+        FLIP_X = 1,
+        FLIP_Y = 2,
+    };
+
+private:
+    // LDtk auto-layers can stack several tiles on the same cell, so a single
+    // LDtk layer may need more than one index texture
+    struct IndexTexture
+    {
+        std::vector<Color> cells;
+        Texture2D texture{};
+    };
+
+    struct Layer
+    {
+        Texture2D tileset{};
+        int tileSize = 0;
+        int spacing = 0;
+        int padding = 0;
+
+        // tiles the tileset has per row and per column
+        int tilesetColumns = 0;
+        int tilesetRows = 0;
+
+        int cellSize = 0;
+        int gridWidth = 0;
+        int gridHeight = 0;
+        Vector2 offset{};
+
+        std::vector<IndexTexture> indexTextures;
+    };
+
+    Shader shader{};
+    int tilesetLoc = -1;
+    int tilesetSizeLoc = -1;
+    int gridSizeLoc = -1;
+    int tileSizeLoc = -1;
+    int tileSpacingLoc = -1;
+    int tilePaddingLoc = -1;
+
+    // ordered bottom-most first
+    std::vector<Layer> layers;
+
+    IndexTexture &get_free_index_texture(Layer &layer, int cellIndex);
+
+public:
+    TileLayerRenderer();
+    ~TileLayerRenderer();
+
+    TileLayerRenderer(const TileLayerRenderer &) = delete;
+    TileLayerRenderer &operator=(const TileLayerRenderer &) = delete;
+
+    // False if the shader couldn't be compiled on this platform, in which case
+    // the caller should fall back to baking the tiles
+    bool is_supported() const;
+
+    // False if one of the level's tilesets has more columns or rows than an
+    // index texel can address (see MaxTilesetCells), nothing is loaded then and
+    // the caller should bake the tiles instead
+    bool load_level(const ldtk::Level *level);
+    void unload();
+
+    // Tile edits only touch the cell's texels, one per index texture the
+    // layer has. The new tile replaces every tile stacked on the cell, tiles
+    // outside of the layer's tileset are ignored.
+    void set_tile(size_t layerIndex, int gridX, int gridY, int tilesetColumn, int tilesetRow, uint8_t flips = FLIP_NONE);
+    void clear_tile(size_t layerIndex, int gridX, int gridY);
+
+    size_t layer_count() const;
+
+    void draw() const;
+};
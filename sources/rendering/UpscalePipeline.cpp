@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <cmath>
+
+#include <raylib.h>
+#include <rlgl.h>
+
+#include <Constants.hpp>
+#include <utils/AssetRegistry.hpp>
+#include <utils/DebugUtils.hpp>
+
+#include "UpscalePipeline.hpp"
+#include "RenderTargetStack.hpp"
+
+namespace
+{
+	// weight of the latest frame in the rolling pass timings
+	constexpr float TimingSmoothing = 0.05f;
+
+	// below this the game isn't readable anymore
+	constexpr float MinResolutionScale = 0.25f;
+
+	// render textures are stored upside down
+	Rectangle get_flipped_source(const RenderTexture2D &target)
+	{
+		return {0, 0, (float)target.texture.width, (float)-target.texture.height};
+	}
+}
+
+UpscalePipeline::UpscalePipeline(const UpscaleConfig &config)
+{
+	set_config(config);
+	update_layout();
+}
+
+UpscalePipeline::~UpscalePipeline()
+{
+	unload_post_targets();
+	UnloadRenderTexture(gameTarget);
+
+	for (auto &&effectShader : effectShaders)
+	{
+		if (effectShader.shader.id != 0)
+		{
+			UnloadShader(effectShader.shader);
+		}
+	}
+}
+
+void UpscalePipeline::set_config(const UpscaleConfig &newConfig)
+{
+	config = newConfig;
+	config.renderScale = std::max(config.renderScale, 1);
+	config.resolutionScale = std::clamp(config.resolutionScale, MinResolutionScale, 1.0f);
+
+	int gameWidth = (int)std::round(GameConstants::WorldWidth * config.resolutionScale);
+	int gameHeight = (int)std::round(GameConstants::WorldHeight * config.resolutionScale);
+	if (gameTarget.texture.width != gameWidth || gameTarget.texture.height != gameHeight)
+	{
+		allocate_game_target(gameWidth, gameHeight);
+	}
+
+	bool postProcessing = !config.postEffects.empty();
+	if (postProcessing)
+	{
+		for (auto effect : config.postEffects)
+		{
+			get_effect_shader(effect);
+		}
+
+		if (postTargetScale != config.renderScale)
+		{
+			allocate_post_targets(config.renderScale);
+		}
+
+		// the upscale to the post-process resolution is always nearest, the
+		// configured filter only applies to the last step into the window
+		SetTextureFilter(gameTarget.texture, TEXTURE_FILTER_POINT);
+		for (auto &&target : postTargets)
+		{
+			SetTextureFilter(target.texture, config.filter);
+		}
+	}
+	else
+	{
+		unload_post_targets();
+		SetTextureFilter(gameTarget.texture, config.filter);
+	}
+
+	timings.clear();
+	if (postProcessing)
+	{
+		timings.push_back({"upscale"});
+		for (auto effect : config.postEffects)
+		{
+			timings.push_back({get_effect_name(effect)});
+		}
+	}
+	timings.push_back({"present"});
+}
+
+const UpscaleConfig &UpscalePipeline::get_config() const
+{
+	return config;
+}
+
+void UpscalePipeline::update_layout()
+{
+	const float windowWidth = (float)GetScreenWidth();
+	const float windowHeight = (float)GetScreenHeight();
+	const float gameWidth = (float)GameConstants::WorldWidth;
+	const float gameHeight = (float)GameConstants::WorldHeight;
+
+	float scaleX = windowWidth / gameWidth;
+	float scaleY = windowHeight / gameHeight;
+
+	switch (config.scaleMode)
+	{
+	case ScaleMode::INTEGER:
+		// windows smaller than the game still get a (cropped) 1x image
+		scaleX = scaleY = std::max(std::floor(std::min(scaleX, scaleY)), 1.0f);
+		break;
+	case ScaleMode::LETTERBOX:
+		scaleX = scaleY = std::min(scaleX, scaleY);
+		break;
+	case ScaleMode::STRETCH:
+		break;
+	}
+
+	viewport.width = gameWidth * scaleX;
+	viewport.height = gameHeight * scaleY;
+	// whole pixels, so integer scaling stays pixel exact
+	viewport.x = std::floor((windowWidth - viewport.width) / 2);
+	viewport.y = std::floor((windowHeight - viewport.height) / 2);
+
+	SetMouseOffset((int)-viewport.x, (int)-viewport.y);
+	SetMouseScale(gameWidth / viewport.width, gameHeight / viewport.height);
+}
+
+void UpscalePipeline::begin_game()
+{
+	RenderTargetStack::push(gameTarget, GameConstants::WorldWidth, GameConstants::WorldHeight);
+}
+
+void UpscalePipeline::end_game()
+{
+	RenderTargetStack::pop();
+}
+
+void UpscalePipeline::present()
+{
+	const RenderTexture2D *source = &gameTarget;
+	size_t pass = 0;
+
+	if (!config.postEffects.empty())
+	{
+		double startTime = GetTime();
+
+		RenderTargetStack::push(postTargets[0]);
+		DrawTexturePro(gameTarget.texture,
+					   get_flipped_source(gameTarget),
+					   {0, 0, (float)postTargets[0].texture.width, (float)postTargets[0].texture.height},
+					   {0, 0},
+					   0,
+					   WHITE);
+		RenderTargetStack::pop();
+		record_timing(pass++, startTime);
+
+		const float sourceSize[2] = {(float)GameConstants::WorldWidth, (float)GameConstants::WorldHeight};
+		int current = 0;
+
+		for (auto effect : config.postEffects)
+		{
+			startTime = GetTime();
+
+			const auto &effectShader = get_effect_shader(effect);
+			if (effectShader.supported)
+			{
+				RenderTargetStack::push(postTargets[1 - current]);
+				BeginShaderMode(effectShader.shader);
+				SetShaderValue(effectShader.shader, effectShader.sourceSizeLoc, sourceSize, SHADER_UNIFORM_VEC2);
+				DrawTextureRec(postTargets[current].texture, get_flipped_source(postTargets[current]), {0, 0}, WHITE);
+				EndShaderMode();
+				RenderTargetStack::pop();
+
+				current = 1 - current;
+			}
+
+			record_timing(pass++, startTime);
+		}
+
+		source = &postTargets[current];
+	}
+
+	double startTime = GetTime();
+	DrawTexturePro(source->texture, get_flipped_source(*source), viewport, {0, 0}, 0, WHITE);
+	rlDrawRenderBatchActive();
+	record_timing(pass, startTime);
+}
+
+Rectangle UpscalePipeline::get_viewport() const
+{
+	return viewport;
+}
+
+std::span<const UpscalePipeline::PassTiming> UpscalePipeline::get_pass_timings() const
+{
+	return timings;
+}
+
+const char *UpscalePipeline::get_effect_name(PostEffect effect)
+{
+	switch (effect)
+	{
+	case PostEffect::CRT:
+		return "crt";
+	case PostEffect::BLOOM:
+		return "bloom";
+	}
+
+	return "unknown";
+}
+
+const UpscalePipeline::EffectShader &UpscalePipeline::get_effect_shader(PostEffect effect)
+{
+	auto &effectShader = effectShaders[(size_t)effect];
+	if (effectShader.shader.id != 0)
+	{
+		return effectShader;
+	}
+
+	auto shaderAsset = effect == PostEffect::CRT ? AssetId::CRT_SHADER : AssetId::BLOOM_SHADER;
+	effectShader.shader = LoadShader(nullptr, AssetRegistry::get_path(shaderAsset));
+
+	// a missing or broken shader file gets raylib's default shader, which
+	// IsShaderValid happily accepts
+	effectShader.supported = IsShaderValid(effectShader.shader) && effectShader.shader.id != rlGetShaderIdDefault();
+
+	if (effectShader.supported)
+	{
+		effectShader.sourceSizeLoc = GetShaderLocation(effectShader.shader, "sourceSize");
+	}
+	else
+	{
+		// the pass is skipped, it would only copy the image with the default shader
+		TraceLog(LOG_WARNING, "Post effect %s is not supported, skipping it", get_effect_name(effect));
+	}
+
+	return effectShader;
+}
+
+void UpscalePipeline::allocate_game_target(int width, int height)
+{
+	if (gameTarget.id != 0)
+	{
+		UnloadRenderTexture(gameTarget);
+	}
+
+	DebugUtils::println("Allocating the game target at {}x{}", width, height);
+	gameTarget = LoadRenderTexture(width, height);
+}
+
+void UpscalePipeline::allocate_post_targets(int scale)
+{
+	unload_post_targets();
+
+	DebugUtils::println("Allocating post-process targets at {}x the game resolution", scale);
+	for (auto &&target : postTargets)
+	{
+		target = LoadRenderTexture(GameConstants::WorldWidth * scale, GameConstants::WorldHeight * scale);
+	}
+	postTargetScale = scale;
+}
+
+void UpscalePipeline::unload_post_targets()
+{
+	for (auto &&target : postTargets)
+	{
+		if (target.id != 0)
+		{
+			UnloadRenderTexture(target);
+			target = {};
+		}
+	}
+	postTargetScale = 0;
+}
+
+void UpscalePipeline::record_timing(size_t pass, double startTime)
+{
+	float elapsedMs = float((GetTime() - startTime) * 1000.0);
+	auto &timing = timings[pass];
+	timing.averageMs += (elapsedMs - timing.averageMs) * TimingSmoothing;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include <raylib.h>
+
+#include <Constants.hpp>
+
+enum class ScaleMode
+{
+    // Largest whole multiple of the game resolution that fits the window, pixels stay square and sharp
+    INTEGER,
+    // Largest scale that fits the window while keeping the aspect ratio
+    LETTERBOX,
+    // Fills the whole window, distorting the aspect ratio
+    STRETCH,
+};
+
+enum class PostEffect
+{
+    CRT,
+    BLOOM,
+};
+
+struct UpscaleConfig
+{
+    ScaleMode scaleMode = ScaleMode::INTEGER;
+
+    // Filter used when the final image is scaled to the window
+    TextureFilter filter = TEXTURE_FILTER_POINT;
+
+    // Resolution post-process passes run at, as a multiple of the game
+    // resolution. The game is upscaled to it with nearest filtering first.
+    int renderScale = ScreenScale;
+
+    // Fraction of the game resolution the game itself is drawn at, lowered by
+    // the QualityGovernor when frames take too long. Scenes still draw in
+    // game pixels, they just end up in a smaller render texture.
+    float resolutionScale = 1.0f;
+
+    // Applied in order, none by default
+    std::vector<PostEffect> postEffects;
+};
+
+/**
+ * Takes the frame the scenes draw at the game resolution to the window. The
+ * game is drawn into its own render texture, optionally upscaled into a pair
+ * of ping-pong render textures that every post-process pass alternates
+ * between, and finally drawn into the window with the configured scale mode.
+ *
+ * Render textures are only (re)allocated when the config changes, never
+ * while rendering. The mouse is mapped back to game coordinates, so scenes
+ * can use GetMousePosition no matter how the game is scaled.
+ */
+class UpscalePipeline
+{
+public:
+    struct PassTiming
+    {
+        const char *name;
+
+        // Exponential moving average of the CPU time the pass took to submit
+        // and flush, raylib doesn't expose GPU timer queries
+        float averageMs = 0;
+    };
+
+private:
+    struct EffectShader
+    {
+        Shader shader{};
+        int sourceSizeLoc = -1;
+
+        // false when loading fell back to raylib's default shader
+        bool supported = false;
+    };
+
+    UpscaleConfig config;
+
+    RenderTexture2D gameTarget{};
+    std::array<RenderTexture2D, 2> postTargets{};
+    int postTargetScale = 0;
+
+    // loaded the first time an effect is enabled, indexed by PostEffect
+    std::array<EffectShader, 2> effectShaders{};
+
+    // where the game ends up in the window
+    Rectangle viewport{};
+
+    // upscale, one entry per post effect, present
+    std::vector<PassTiming> timings;
+
+    const EffectShader &get_effect_shader(PostEffect effect);
+    void allocate_game_target(int width, int height);
+    void allocate_post_targets(int scale);
+    void unload_post_targets();
+    void record_timing(size_t pass, double startTime);
+
+public:
+    explicit UpscalePipeline(const UpscaleConfig &config = {});
+    ~UpscalePipeline();
+
+    UpscalePipeline(const UpscalePipeline &) = delete;
+    UpscalePipeline &operator=(const UpscalePipeline &) = delete;
+
+    void set_config(const UpscaleConfig &newConfig);
+    const UpscaleConfig &get_config() const;
+
+    // Fits the viewport to the current window size and maps the mouse to it,
+    // call once per frame before the scenes read any input
+    void update_layout();
+
+    // Everything drawn between these ends up in the game render texture
+    void begin_game();
+    void end_game();
+
+    // Runs the post-process passes and draws the result into the viewport,
+    // call between BeginDrawing and EndDrawing
+    void present();
+
+    Rectangle get_viewport() const;
+    std::span<const PassTiming> get_pass_timings() const;
+
+    static const char *get_effect_name(PostEffect effect);
+};
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <raylib.h>
 #include <box2d/box2d.h>
@@ -7,77 +8,329 @@
 
 #include <Constants.hpp>
 #include <utils/DebugUtils.hpp>
+#include <utils/AllocationTracker.hpp>
+#include <utils/AssetRegistry.hpp>
+#include <utils/AssetStreamer.hpp>
+#include <utils/CookedTexture.hpp>
 
 #include "GameScene.hpp"
+#include "../../audio/AudioEngine.hpp"
 #include "../../physics/PhysicsTypes.hpp"
+#include "../../effects/ParticlePresets.hpp"
+#include "../../rendering/QualityGovernor.hpp"
+#include "../../rendering/RenderTargetStack.hpp"
 #include "../Scenes.hpp"
 
 #include "./entities/BaseEntity.hpp"
 
 using namespace std;
 
-std::unique_ptr<Player> GameScene::player = nullptr;
-std::unique_ptr<b2World> GameScene::world = nullptr;
-
 GameScene::GameScene()
+	: jumpDustEmitter(ParticlePresets::JumpDust()),
+	  landingEmitter(ParticlePresets::LandingImpact())
 {
-	player = std::make_unique<Player>();
+	simulation.get_player()->load_sprite();
+	simulation.get_actors().load_sprites();
 	ldtkProject = std::make_unique<ldtk::Project>();
 
-	ldtkProject->loadFromFile(AppConstants::GetAssetPath("world.ldtk"));
+	ldtkProject->loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
 
 	ldtkWorld = &ldtkProject->getWorld();
 
+	if (RenderingConstants::GpuTileLayers)
+	{
+		tileLayerRenderer = std::make_unique<TileLayerRenderer>();
+		if (!tileLayerRenderer->is_supported())
+		{
+			DebugUtils::println("Tile layer shader is not supported, falling back to baked tile layers");
+			tileLayerRenderer = nullptr;
+		}
+	}
+
 	current_level = -1;
-	set_selected_level(0);
+
+	if (StreamingConstants::Enabled)
+	{
+		start_streaming_world();
+	}
+	else
+	{
+		request_level(0);
+	}
 }
 
 GameScene::~GameScene()
 {
+	AllocationTracker::disarm_budget();
+
+	// in streaming mode the level streamer owns all level textures
+	if (levelStreamer != nullptr)
+	{
+		return;
+	}
+
 	UnloadTexture(renderedLevelTexture);
-	UnloadTexture(currentTilesetTexture);
+	if (tileLayerRenderer == nullptr)
+	{
+		UnloadTexture(currentTilesetTexture);
+	}
 }
 
 Scenes GameScene::tick(float dt)
 {
-	const float timeStep = 1.0f / 60.0f;
-	const int32 velocityIterations = 6;
-	const int32 positionIterations = 2;
+	AllocationTracker::Scope allocationScope("GameScene::tick");
+
+	if (pending_level >= 0)
+	{
+		if (!AssetStreamer::is_level_ready(ldtkWorld->getLevel(pending_level).name))
+		{
+			ClearBackground(RAYWHITE);
+			DrawText("Loading...", 10, 10, 20, GRAY);
+			return Scenes::NONE;
+		}
+
+		TraceLog(LOG_INFO, "Level %d is ready after %.1f ms", pending_level, GetTime() * 1000.0);
+		set_selected_level(pending_level);
+		pending_level = -1;
+	}
+
+	auto player = simulation.get_player();
+
+	// the simulation runs at a fixed rate no matter the frame rate. A jump
+	// press is kept until a tick consumes it so it isn't lost on fast frames.
+	auto input = PlayerInput::from_keyboard();
+	input.jump = input.jump || pendingJump;
+	pendingJump = input.jump;
 
-	world->Step(timeStep, velocityIterations, positionIterations);
-	player->update(dt);
+	// without streaming the whole level fits on screen, so the camera is its center
+	Vector2 cameraCenter = levelStreamer != nullptr
+							   ? camera.target
+							   : Vector2{GameConstants::WorldWidth / 2.0f, GameConstants::WorldHeight / 2.0f};
+	simulation.set_actor_focus(cameraCenter);
+
+	// a frame may run zero or several ticks, effects trigger on any of them
+	bool jumped = false;
+	bool landed = false;
+
+	tickAccumulator = std::min(tickAccumulator + dt, GameConstants::MaxTicksPerFrame * GameConstants::TickDuration);
+	while (tickAccumulator >= GameConstants::TickDuration)
+	{
+		simulation.step(input);
+		tickAccumulator -= GameConstants::TickDuration;
+
+		jumped = jumped || player->has_jumped();
+		landed = landed || player->has_landed();
+
+		input.jump = false;
+		pendingJump = false;
+	}
+
+	// chasing enemies head wherever the player was when the last field was done
+	if (flowFieldWorker != nullptr)
+	{
+		flowFieldWorker->request(player->get_position());
+		flowFieldWorker->update();
+		simulation.get_actors().set_flow_field(&flowFieldWorker->get_field());
+	}
+
+	update_effects(dt, jumped, landed);
+	play_sounds(jumped, landed, cameraCenter);
+
+	physicsDebugRenderer.handle_input();
+	lighting.handle_input();
+	lighting.move_light(playerLight, player->get_position());
 
 	ClearBackground(RAYWHITE);
+
+	if (levelStreamer != nullptr)
+	{
+		if (levelStreamer->update(player->get_position()))
+		{
+			physicsDebugRenderer.invalidate();
+		}
+
+		camera.target = player->get_position();
+
+		// levels are placed side by side, so the origin tells them apart
+		auto grid = levelStreamer->get_collision_grid_at(player->get_position());
+		if (grid != nullptr && (!litLevelOrigin || litLevelOrigin->x != grid->get_origin().x || litLevelOrigin->y != grid->get_origin().y))
+		{
+			lighting.set_occluders(*grid);
+			litLevelOrigin = grid->get_origin();
+		}
+
+		BeginMode2D(camera);
+		levelStreamer->draw();
+		simulation.get_actors().draw();
+		player->draw();
+		draw_effects();
+		EndMode2D();
+
+		lighting.draw(camera);
+
+		BeginMode2D(camera);
+		draw_debug_overlays();
+		EndMode2D();
+
+		return Scenes::NONE;
+	}
 	
 	DrawTextureRec(renderedLevelTexture,
 				{0, 0, (float)renderedLevelTexture.width, (float)-renderedLevelTexture.height},
 				{0, 0}, WHITE);
+
+	if (tileLayerRenderer != nullptr)
+	{
+		tileLayerRenderer->draw();
+	}
 	
+	simulation.get_actors().draw();
 	player->draw();
+	draw_effects();
 
-	// DEBUG stuff
-	DebugUtils::draw_physics_objects_bounding_boxes(world.get());
+	// the whole level is on screen, world pixels are game pixels
+	lighting.draw({.zoom = 1.0f});
+
+	draw_debug_overlays();
 
 	return Scenes::NONE;
 }
 
-void GameScene::set_selected_level(int lvl)
+const CollisionGrid &GameScene::get_collision_grid() const
 {
-	// unload current tileset texture if necessary
-	if (current_level >= 0)
+	return simulation.get_collision_grid();
+}
+
+void GameScene::update_effects(float dt, bool jumped, bool landed)
+{
+	auto player = simulation.get_player();
+
+	// slow frames get fewer particles, see QualityGovernor
+	float particleFraction = QualityGovernor::get_level().particleFraction;
+	jumpDustEmitter.set_max_particles(int(jumpDustEmitter.get_capacity() * particleFraction));
+	landingEmitter.set_max_particles(int(landingEmitter.get_capacity() * particleFraction));
+
+	// particles come out of the player's feet
+	auto feet = player->get_position();
+	feet.y += 12;
+
+	if (jumped)
 	{
-		UnloadTexture(currentTilesetTexture);
+		jumpDustEmitter.emit(feet, 12);
+	}
+
+	if (landed)
+	{
+		landingEmitter.emit(feet, 16);
+	}
+
+	jumpDustEmitter.update(dt);
+	landingEmitter.update(dt);
+}
+
+void GameScene::play_sounds(bool jumped, bool landed, Vector2 listener)
+{
+	auto player = simulation.get_player();
+
+	// sounds come from where the player is on screen
+	float pan = (player->get_position().x - listener.x) / (GameConstants::WorldWidth / 2.0f);
+
+	if (jumped)
+	{
+		AudioEngine::play(SoundEffect::JUMP, 1.0f, pan);
 	}
 
-	if (world != nullptr)
+	if (landed)
+	{
+		AudioEngine::play(SoundEffect::LAND, 1.0f, pan);
+	}
+
+	// the player respawns from falling out of the level and from hazards,
+	// loading a level resets the count without a respawn
+	if (player->get_respawn_count() != lastRespawnCount)
+	{
+		if (player->get_respawn_count() > lastRespawnCount)
+		{
+			AudioEngine::play(SoundEffect::RESPAWN);
+		}
+		lastRespawnCount = player->get_respawn_count();
+	}
+}
+
+void GameScene::draw_debug_overlays()
+{
+	// off on the lower quality levels no matter what F1 says
+	if (QualityGovernor::get_level().debugOverlays)
 	{
-		// if we had an old world then delete it and recreate
-		// a new one for the new level
-		world = nullptr;
+		physicsDebugRenderer.draw(simulation.get_world());
 	}
+}
+
+void GameScene::add_player_light()
+{
+	playerLight = lighting.add_light({
+		.position = simulation.get_player()->get_position(),
+		.radius = LightingConstants::PlayerLightRadius,
+		.color = {255, 230, 190, 255},
+		.isStatic = false,
+	});
+}
+
+void GameScene::draw_effects() const
+{
+	jumpDustEmitter.draw();
+	landingEmitter.draw();
+}
+
+void GameScene::start_streaming_world()
+{
+	// the old streamer's levels have bodies and actors in the world that's about to go away
+	levelStreamer.reset();
+	simulation.reset_world();
 
-	b2Vec2 gravity(0.0f, 60.0f);
-	world = std::make_unique<b2World>(gravity);
+	levelStreamer = std::make_unique<LevelStreamer>(ldtkWorld, simulation.get_world(), &simulation.get_actors());
+
+	// the player starts wherever it is placed in the first level
+	currentLdtkLevel = &ldtkWorld->getLevel(0);
+	auto levelRect = LevelStreamer::get_level_rect(currentLdtkLevel);
+
+	for (auto &&entity : currentLdtkLevel->getLayer("Entities").allEntities())
+	{
+		if (entity.getName() == "Player")
+		{
+			simulation.spawn_players(&entity, {levelRect.x, levelRect.y});
+		}
+	}
+
+	auto player = simulation.get_player();
+	player->set_respawn_bounds(levelStreamer->get_world_bounds());
+
+	camera.offset = {GameConstants::WorldWidth / 2.0f, GameConstants::WorldHeight / 2.0f};
+	camera.target = player->get_position();
+	camera.zoom = 1.0f;
+
+	levelStreamer->update(player->get_position());
+	physicsDebugRenderer.invalidate();
+
+	// streamed levels only get the player's light, the occluders follow the player
+	lighting.clear_lights();
+	add_player_light();
+	litLevelOrigin.reset();
+}
+
+void GameScene::request_level(int lvl)
+{
+	pending_level = lvl;
+	AssetStreamer::request_level(ldtkWorld->getLevel(lvl).name);
+}
+
+void GameScene::set_selected_level(int lvl)
+{
+	// unload current tileset texture if necessary
+	if (current_level >= 0 && tileLayerRenderer == nullptr)
+	{
+		UnloadTexture(currentTilesetTexture);
+	}
 
 	current_level = lvl;
 
@@ -99,13 +352,13 @@ void GameScene::set_selected_level(int lvl)
 	auto levelSize = currentLdtkLevel->size;
 	auto renderTexture = LoadRenderTexture(levelSize.x, levelSize.y);
 
-	BeginTextureMode(renderTexture);
+	RenderTargetStack::push(renderTexture);
 
 	if (currentLdtkLevel->hasBgImage())
 	{
 		DebugUtils::println("Drawing background image");
 		auto backgroundPath = currentLdtkLevel->getBgImage();
-		auto backgroundTexture = LoadTexture(AppConstants::GetAssetPath(backgroundPath.path.c_str()).c_str());
+		auto backgroundTexture = CookedTexture::load_asset_texture(backgroundPath.path.c_str());
 		SetTextureFilter(backgroundTexture, TEXTURE_FILTER_TRILINEAR);
 
 		// tile background texture to cover the whole frame buffer
@@ -118,12 +371,18 @@ void GameScene::set_selected_level(int lvl)
 		}
 	}
 
-	// draw all tileset layers
+	// draw all tileset layers, unless the GPU renderer takes care of them
+	if (tileLayerRenderer != nullptr && !tileLayerRenderer->load_level(currentLdtkLevel))
+	{
+		DebugUtils::println("Level can't be drawn by the tile layer shader, falling back to baked tile layers");
+		tileLayerRenderer = nullptr;
+	}
+
 	for (auto &&layer : currentLdtkLevel->allLayers())
 	{
-		if (layer.hasTileset())
+		if (layer.hasTileset() && tileLayerRenderer == nullptr)
 		{
-			currentTilesetTexture = LoadTexture(AppConstants::GetAssetPath(layer.getTileset().path).c_str());
+			currentTilesetTexture = CookedTexture::load_asset_texture(layer.getTileset().path);
 			// if it is a tile layer then draw every tile to the frame buffer
 			for (auto &&tile : layer.allTiles())
 			{
@@ -147,54 +406,25 @@ void GameScene::set_selected_level(int lvl)
 		}
 	}
 
-	EndTextureMode();
+	RenderTargetStack::pop();
 	renderedLevelTexture = renderTexture.texture;
 
-	// get entity positions
-	DebugUtils::println("Entities in level:");
-	for (auto &&entity : currentLdtkLevel->getLayer("Entities").allEntities())
-	{
-		DebugUtils::println("  - {}", entity.getName());
-		if (entity.getName() == "Player")
-		{
-			player->init_for_level(&entity, world.get());
-		}
-
-		if (entity.getName() == "Portal")
-		{
-			float target_lvl = entity.getField<float>("level_destination").value();
-			DebugUtils::println("Portal goes to level: {}", target_lvl);
-		}
-	}
-
-	// create solid blocks on level
-	DebugUtils::println("Loading solid blocks in level:");
-	for (auto &&entity : currentLdtkLevel->getLayer("PhysicsEntities").allEntities())
-	{
-		// box2d width and height start from the center of the box
-		auto b2width = entity.getSize().x / 2.0f;
-		auto b2height = entity.getSize().y / 2.0f;
-
-		auto centerX = entity.getPosition().x + b2width;
-		auto centerY = entity.getPosition().y + b2height;
-
-		b2BodyDef bodyDef;
-		bodyDef.userData.pointer = (uintptr_t)PhysicsTypes::SolidBlock.c_str();
-		bodyDef.position.Set(centerX / GameConstants::PhysicsWorldScale,
-							 centerY / GameConstants::PhysicsWorldScale);
+	// creates a new physics world with the level's colliders, actors and the player
+	simulation.load_level(currentLdtkLevel);
+	physicsDebugRenderer.invalidate();
 
-		b2Body *body = world->CreateBody(&bodyDef);
+	// the old worker may still be reading the old graph
+	simulation.get_actors().set_flow_field(nullptr);
+	flowFieldWorker.reset();
+	navigationGraph = std::make_unique<NavigationGraph>(NavigationGraph::from_grid(simulation.get_collision_grid()));
+	flowFieldWorker = std::make_unique<FlowFieldWorker>(navigationGraph.get());
+	DebugUtils::println("Navigation graph has {} nodes and {} links", navigationGraph->get_node_count(), navigationGraph->get_link_count());
 
-		b2PolygonShape groundBox;
-		groundBox.SetAsBox(b2width / GameConstants::PhysicsWorldScale,
-						   b2height / GameConstants::PhysicsWorldScale);
+	lighting.load_level(currentLdtkLevel, simulation.get_collision_grid());
+	add_player_light();
 
-		body->CreateFixture(&groundBox, 0.0f);
-
-		DebugUtils::println("  - x:{} y:{} width:{} height:{}",
-							centerX,
-							centerY,
-							b2width,
-							b2height);
-	}
+	// loading a level allocates a lot, so only start enforcing the allocation
+	// budget once the level has been running for a bit
+	AllocationTracker::set_frame_budget(ProfilingConstants::FrameAllocationBudget);
+	AllocationTracker::arm_budget(ProfilingConstants::AllocationWarmupFrames);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory> 
+#include <optional>
 #include <box2d/box2d.h>
 #include <raylib.h>
 #include <LDtkLoader/Project.hpp>
@@ -10,6 +11,15 @@
 #include "../Scenes.hpp"
 
 #include "../../entities/Player/Player.hpp"
+#include "../../lighting/LightingSystem.hpp"
+#include "../../navigation/FlowFieldWorker.hpp"
+#include "../../navigation/NavigationGraph.hpp"
+#include "../../rendering/PhysicsDebugRenderer.hpp"
+#include "../../rendering/TileLayerRenderer.hpp"
+#include "../../world/LevelStreamer.hpp"
+#include "../../world/Simulation.hpp"
+#include "../../effects/ParticleEmitter.hpp"
+#include "../../physics/CollisionGrid.hpp"
 #include "./entities/BaseEntity.hpp"
 
 class GameScene : public BaseScene
@@ -17,6 +27,9 @@ class GameScene : public BaseScene
 private:
     int current_level;
 
+    // level waiting for its assets to be streamed in, -1 if none
+    int pending_level = -1;
+
     std::unique_ptr<ldtk::Project> ldtkProject;
     const ldtk::World *ldtkWorld{};
     const ldtk::Level *currentLdtkLevel{};
@@ -24,14 +37,59 @@ private:
     Texture2D currentTilesetTexture;
     Texture2D renderedLevelTexture;
 
+    // physics world, player and actors of the level being played, declared
+    // before the level streamer since it adds bodies to this simulation's
+    // world. Only the game's actors get a CPU budget.
+    Simulation simulation{1, ActorConstants::TickBudgetMs};
+
+    // where ground enemies can go in the current level and the way to the
+    // player from everywhere in it, the worker reads the graph
+    std::unique_ptr<NavigationGraph> navigationGraph;
+    std::unique_ptr<FlowFieldWorker> flowFieldWorker;
+
+    // time not yet simulated, always less than one tick after a frame
+    float tickAccumulator = 0.0f;
+    bool pendingJump = false;
+
+    // respawn count of the player when sounds were last played
+    int lastRespawnCount = 0;
+
+    // only set when tile layers are drawn on the GPU instead of being baked
+    std::unique_ptr<TileLayerRenderer> tileLayerRenderer;
+
+    // only set in streaming mode, see StreamingConstants
+    std::unique_ptr<LevelStreamer> levelStreamer;
+    Camera2D camera{};
+
+    ParticleEmitter jumpDustEmitter;
+    ParticleEmitter landingEmitter;
+
+    // F1 toggles it, on by default in debug builds
+    PhysicsDebugRenderer physicsDebugRenderer;
+
+    // the player carries a light of its own, in streaming mode the occluders
+    // are those of the level the player is in
+    LightingSystem lighting;
+    int playerLight = -1;
+    std::optional<Vector2> litLevelOrigin;
+
+    void start_streaming_world();
+    void update_effects(float dt, bool jumped, bool landed);
+    void play_sounds(bool jumped, bool landed, Vector2 listener);
+    void add_player_light();
+    void draw_effects() const;
+    void draw_debug_overlays();
+
 public:
     GameScene();
     ~GameScene();
 
-    static std::unique_ptr<b2World> world;
-    static std::unique_ptr<Player> player;
-
     Scenes tick(float dt) override;
 
     void set_selected_level(int lvl);
+
+    // Switches to the level once its assets are available, see AssetStreamer
+    void request_level(int lvl);
+
+    const CollisionGrid &get_collision_grid() const;
 };
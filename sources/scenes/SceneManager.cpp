@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "SceneManager.hpp"
+#include "TitleScene/TitleScene.hpp"
+#include "GameScene/GameScene.hpp"
+
+std::unique_ptr<BaseScene> SceneManager::current_screen = nullptr;
+Scenes SceneManager::current_screen_id = UNSET;
+
+void SceneManager::initialize()
+{
+	SceneManager::set_current_screen(UNSET);
+}
+
+void SceneManager::set_current_screen(Scenes screen)
+{
+	if (screen == NONE)
+	{
+		return;
+	}
+
+	SceneManager::current_screen.reset();
+
+	switch (screen)
+	{
+	case UNSET:
+		SceneManager::current_screen = nullptr;
+		break;
+	case TITLE:
+		SceneManager::current_screen = std::make_unique<TitleScene>();
+		break;
+	case GAME:
+		SceneManager::current_screen = std::make_unique<GameScene>();
+		break;
+	case NONE:
+		std::cerr << "Landed in NONE case for switch. This should never happen!" << std::endl;
+		exit(1);
+	}
+
+	SceneManager::current_screen_id = screen;
+}
+
+Scenes SceneManager::get_current_screen()
+{
+	return SceneManager::current_screen_id;
+}
+
+void SceneManager::tick(float dt)
+{
+	if (SceneManager::current_screen != nullptr)
+	{
+		Scenes result = SceneManager::current_screen->tick(dt);
+		if (result != NONE)
+		{
+			SceneManager::set_current_screen(result);
+		}
+	}
+}
+
+void SceneManager::cleanup()
+{
+	if (SceneManager::current_screen != nullptr)
+	{
+		SceneManager::current_screen = nullptr;
+	}
+
+	SceneManager::current_screen_id = UNSET;
+}
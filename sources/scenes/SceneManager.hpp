@@ -1,8 +1,6 @@
 #pragma once
 
 #include "BaseScene.hpp"
-#include "TitleScene/TitleScene.hpp"
-#include "GameScene/GameScene.hpp"
 #include "Scenes.hpp"
 
 #include <memory>
@@ -11,63 +9,14 @@ class SceneManager
 {
 private:
 	static std::unique_ptr<BaseScene> current_screen;
+	static Scenes current_screen_id;
 
 public:
 	static void set_current_screen(Scenes screen);
+
+	// UNSET before the first scene and after cleanup
+	static Scenes get_current_screen();
 	static void initialize();
 	static void tick(float dt);
 	static void cleanup();
-};
-
-std::unique_ptr<BaseScene> SceneManager::current_screen = nullptr;
-
-void SceneManager::initialize()
-{
-	SceneManager::set_current_screen(UNSET);
-}
-
-void SceneManager::set_current_screen(Scenes screen)
-{
-	if (screen == NONE)
-	{
-		return;
-	}
-
-	SceneManager::current_screen.reset();
-
-	switch (screen)
-	{
-	case UNSET:
-		SceneManager::current_screen = nullptr;
-		break;
-	case TITLE:
-		SceneManager::current_screen = std::make_unique<TitleScene>();
-		break;
-	case GAME:
-		SceneManager::current_screen = std::make_unique<GameScene>();
-		break;
-	case NONE:
-		std::cerr << "Landed in NONE case for switch. This should never happen!" << std::endl;
-		exit(1);
-	}
-}
-
-void SceneManager::tick(float dt)
-{
-	if (SceneManager::current_screen != nullptr)
-	{
-		Scenes result = SceneManager::current_screen->tick(dt);
-		if (result != NONE)
-		{
-			SceneManager::set_current_screen(result);
-		}
-	}
-}
-
-void SceneManager::cleanup()
-{
-	if (SceneManager::current_screen != nullptr)
-	{
-		SceneManager::current_screen = nullptr;
-	}
-}
\ No newline at end of file
+};
\ No newline at end of file
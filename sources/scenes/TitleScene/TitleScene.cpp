@@ -1,9 +1,14 @@
+#include <cstring>
 #include <string>
 
 #include <raylib.h>
+
+// raygui is header only, its implementation is compiled in this one file
+#define RAYGUI_IMPLEMENTATION
 #include <raygui.h>
 
 #include <Constants.hpp>
+#include <utils/CookedTexture.hpp>
 #include <utils/DebugUtils.hpp>
 
 #include "TitleScene.hpp"
@@ -11,10 +16,49 @@
 
 using namespace std;
 
+namespace
+{
+	// Define panel positions
+	constexpr float LeftPanel = 10;
+	constexpr float RightPanel = GameConstants::WorldWidth - 160;
+
+	// Component bounds, also used to tell which input can change the UI
+	constexpr Rectangle StartButtonRect = {LeftPanel, 95, 120, 30};
+	constexpr Rectangle CheckBoxRect = {LeftPanel, 135, 20, 20};
+	constexpr Rectangle TextBoxRect = {LeftPanel, 165, 120, 25};
+	constexpr Rectangle DropdownRect = {LeftPanel, 200, 120, 25};
+	constexpr Rectangle MessageBoxButtonRect = {RightPanel, 95, 140, 30};
+	constexpr Rectangle ColorPickerRect = {RightPanel, 155, 120, 120};
+	constexpr Rectangle MessageBoxRect = {GameConstants::WorldWidth / 2 - 125, GameConstants::WorldHeight / 2 - 50, 250, 100};
+
+	constexpr int DropdownOptionCount = 3;
+
+	// raygui draws the hue bar and the checkbox text outside of their bounds
+	Rectangle grow_right(Rectangle rect, float amount)
+	{
+		return {rect.x, rect.y, rect.width + amount, rect.height};
+	}
+}
+
 TitleScene::TitleScene()
+	: uiLayer(GameConstants::WorldWidth, GameConstants::WorldHeight, RAYWHITE)
 {
 	// Load assets
-	texture = LoadTexture(AppConstants::GetAssetPath("test.png").c_str());
+	texture = CookedTexture::load_asset_texture(AssetId::TITLE_TEXTURE);
+
+	// Labels never change, so they are rendered once with their backdrop
+	titleLabel = labels.add("This is the Title Scene", 25, GOLD, BLACK);
+	leftPanelLabel = labels.add("RayGUI Examples", 15, BLACK, WHITE);
+	rightPanelLabel = labels.add("Interactive Examples", 15, BLACK, WHITE);
+	colorPickerLabel = labels.add("Color Picker:", 10, BLACK, WHITE);
+	labels.build();
+
+	// Set smaller text size and color selector for GUI components, once for
+	// the whole scene instead of around every frame's UI
+	previousTextSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
+	previousColorSelectorSize = GuiGetStyle(COLORPICKER, COLOR_SELECTOR_SIZE);
+	GuiSetStyle(DEFAULT, TEXT_SIZE, 10);
+	GuiSetStyle(COLORPICKER, COLOR_SELECTOR_SIZE, 6);
 
 	// Initialize GUI component states
 	checkboxState = false;
@@ -26,18 +70,17 @@ TitleScene::TitleScene()
 	showMessageBox = false;
 	messageBoxOkClicked = false;
 
-	// Initialize virtual mouse (scaled for GUI components)
-	SetMouseScale(1.0f / (float)ScreenScale, 1.0f / (float)ScreenScale);
+	// The mouse is already mapped to game coordinates by the upscale pipeline
 	HideCursor(); // Hide OS cursor since we'll draw our own
 }
 
 TitleScene::~TitleScene()
 {
-	// Restore default mouse settings when exiting the scene
-	SetMouseScale(1.0f, 1.0f);
-	SetMouseOffset(0, 0);
 	ShowCursor();
 
+	GuiSetStyle(DEFAULT, TEXT_SIZE, previousTextSize);
+	GuiSetStyle(COLORPICKER, COLOR_SELECTOR_SIZE, previousColorSelectorSize);
+
 	// Unload assets
 	UnloadTexture(texture);
 }
@@ -48,52 +91,93 @@ Scenes TitleScene::tick(float dt)
 	ClearBackground(RAYWHITE);
 	virtualMousePosition = GetMousePosition();
 
-	auto draw_with_backdrop = [](const string &text, int x, int y, int fontSize, Color color, Color backdropColor)
+	// Only run (and draw) the GUI when input could change it, otherwise
+	// the cached UI from the last repaint is shown as is
+	invalidate_ui_on_input();
+	uiLayer.repaint_if_needed([this]()
+							  { draw_ui(); });
+
+	uiLayer.draw();
+
+	//=================================================================
+	// CUSTOM MOUSE CURSOR
+	//=================================================================
+
+	// here you could use a custom cursor texture but since we're lazy we'll
+	// just draw a rectangle
+
+	int rectSize = GameConstants::WorldWidth / 40;
+	DrawRectangle(virtualMousePosition.x - rectSize / 2, virtualMousePosition.y - rectSize / 2,
+				  rectSize, rectSize, Fade(DARKPURPLE, 0.3f));
+
+	// Scene transition logic
+	return nextScene;
+}
+
+void TitleScene::invalidate_ui_on_input()
+{
+	// the text box takes keyboard input while focused
+	if (textBoxFocused)
+	{
+		uiLayer.invalidate();
+	}
+
+	if (showMessageBox)
+	{
+		// the message box is modal, only its own input matters
+		const Rectangle modalAreas[] = {MessageBoxRect};
+		uiLayer.invalidate_on_input(modalAreas);
+		return;
+	}
+
+	// an open dropdown covers the components below it
+	Rectangle dropdownArea = DropdownRect;
+	if (dropdownEditMode)
 	{
-		DrawText(text.c_str(), x + 1, y + 1, fontSize, backdropColor);
-		DrawText(text.c_str(), x, y, fontSize, color);
+		dropdownArea.height *= DropdownOptionCount + 1;
+	}
+
+	const Rectangle interactiveAreas[] = {
+		StartButtonRect,
+		grow_right(CheckBoxRect, 100),
+		TextBoxRect,
+		dropdownArea,
+		MessageBoxButtonRect,
+		grow_right(ColorPickerRect, 30),
 	};
+	uiLayer.invalidate_on_input(interactiveAreas);
+}
 
-	draw_with_backdrop("This is the Title Scene", 10, 10, 25, GOLD, BLACK);
+void TitleScene::draw_ui()
+{
+	labels.draw(titleLabel, {10, 10});
 
 	// Draw centered texture
 	const int texture_x = (GameConstants::WorldWidth / 2) - (texture.width / 2);
 	const int texture_y = (GameConstants::WorldHeight / 2) - (texture.height / 2) + 30;
 	DrawTextureEx(texture, Vector2{(float)texture_x, (float)texture_y}, 0, 1, WHITE);
 
-	// Set smaller text size for GUI components
-	GuiSetStyle(DEFAULT, TEXT_SIZE, 10);
-
-	// Define panel positions
-	const int leftPanel = 10;
-	const int rightPanel = GameConstants::WorldWidth - 160;
-
-	// Save initial style properties
-	const int defaultTextSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
-	const int defaultColorPickerSize = GuiGetStyle(COLORPICKER, COLOR_SELECTOR_SIZE);
-
 	//=================================================================
 	// LEFT PANEL - BASIC GUI COMPONENTS
 	//=================================================================
-	draw_with_backdrop("RayGUI Examples", leftPanel, 70, 15, BLACK, WHITE);
+	labels.draw(leftPanelLabel, {LeftPanel, 70});
 
-	if( GuiButton(Rectangle{leftPanel, 95, 120, 30}, "Start Game")){
+	if (GuiButton(StartButtonRect, "Start Game"))
+	{
 		// Transition to the game scene
-		return Scenes::GAME;
+		nextScene = Scenes::GAME;
 	}
 
-	GuiCheckBox(Rectangle{leftPanel, 135, 20, 20}, "Enable Feature", &checkboxState);
+	GuiCheckBox(CheckBoxRect, "Enable Feature", &checkboxState);
 
-	Rectangle textBoxRect = {leftPanel, 165, 120, 25};
 	if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
 	{
 		// Update focus state when mouse is clicked
-		textBoxFocused = CheckCollisionPointRec(GetMousePosition(), textBoxRect);
+		textBoxFocused = CheckCollisionPointRec(GetMousePosition(), TextBoxRect);
 	}
-	GuiTextBox(textBoxRect, textBoxText, 64, textBoxFocused);
+	GuiTextBox(TextBoxRect, textBoxText, 64, textBoxFocused);
 
-	Rectangle dropdownRect = {leftPanel, 200, 120, 25};
-	if (GuiDropdownBox(dropdownRect, "Option 1;Option 2;Option 3", &dropdownIndex, dropdownEditMode))
+	if (GuiDropdownBox(DropdownRect, "Option 1;Option 2;Option 3", &dropdownIndex, dropdownEditMode))
 	{
 		dropdownEditMode = !dropdownEditMode;
 	}
@@ -101,24 +185,19 @@ Scenes TitleScene::tick(float dt)
 	//=================================================================
 	// RIGHT PANEL - INTERACTIVE GUI COMPONENTS
 	//=================================================================
-	draw_with_backdrop("Interactive Examples", rightPanel, 70, 15, BLACK, WHITE);
+	labels.draw(rightPanelLabel, {RightPanel, 70});
 
-	if (GuiButton(Rectangle{rightPanel, 95, 140, 30}, "Show Message Box"))
+	if (GuiButton(MessageBoxButtonRect, "Show Message Box"))
 	{
 		showMessageBox = true;
 	}
 
-	draw_with_backdrop("Color Picker:", rightPanel, 135, 10, BLACK, WHITE);
-	GuiSetStyle(COLORPICKER, COLOR_SELECTOR_SIZE, 6); // Smaller selector
-	GuiColorPicker(Rectangle{rightPanel, 155, 120, 120}, NULL, &colorPickerValue);
+	labels.draw(colorPickerLabel, {RightPanel, 135});
+	GuiColorPicker(ColorPickerRect, NULL, &colorPickerValue);
 
 	// Display selected color
-	DrawRectangle(rightPanel + 30, 285, 80, 30, colorPickerValue);
-	DrawRectangleLines(rightPanel + 30, 285, 80, 30, BLACK);
-
-	// Restore original style properties
-	GuiSetStyle(DEFAULT, TEXT_SIZE, defaultTextSize);
-	GuiSetStyle(COLORPICKER, COLOR_SELECTOR_SIZE, defaultColorPickerSize);
+	DrawRectangle(RightPanel + 30, 285, 80, 30, colorPickerValue);
+	DrawRectangleLines(RightPanel + 30, 285, 80, 30, BLACK);
 
 	//=================================================================
 	// MODAL DIALOG HANDLING
@@ -129,7 +208,7 @@ Scenes TitleScene::tick(float dt)
 		DrawRectangle(0, 0, GameConstants::WorldWidth, GameConstants::WorldHeight, Fade(RAYWHITE, 0.8f));
 
 		int result = GuiMessageBox(
-			Rectangle{GameConstants::WorldWidth / 2 - 125, GameConstants::WorldHeight / 2 - 50, 250, 100},
+			MessageBoxRect,
 			"Message Box",
 			"This is an example message.\nClick OK to continue.",
 			"OK");
@@ -139,18 +218,4 @@ Scenes TitleScene::tick(float dt)
 			showMessageBox = false;
 		}
 	}
-
-	//=================================================================
-	// CUSTOM MOUSE CURSOR
-	//=================================================================
-
-	// here you could use a custom cursor texture but since we're lazy we'll
-	// just draw a rectangle
-
-	int rectSize = GameConstants::WorldWidth / 40;
-	DrawRectangle(virtualMousePosition.x - rectSize / 2, virtualMousePosition.y - rectSize / 2,
-				  rectSize, rectSize, Fade(DARKPURPLE, 0.3f));
-
-	// Scene transition logic
-	return Scenes::NONE;
-}
\ No newline at end of file
+}
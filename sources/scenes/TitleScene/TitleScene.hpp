@@ -3,6 +3,8 @@
 #include <string>
 
 #include "../BaseScene.hpp"
+#include "../../rendering/CachedUiLayer.hpp"
+#include "../../rendering/LabelAtlas.hpp"
 
 class TitleScene : public BaseScene
 {
@@ -12,6 +14,22 @@ private:
 	
 	// Virtual mouse handling
 	Vector2 virtualMousePosition;
+
+	// The whole UI except the mouse cursor, only redrawn on input
+	CachedUiLayer uiLayer;
+	LabelAtlas labels;
+
+	int titleLabel;
+	int leftPanelLabel;
+	int rightPanelLabel;
+	int colorPickerLabel;
+
+	// raygui style values before this scene changed them
+	int previousTextSize;
+	int previousColorSelectorSize;
+
+	// scene requested by the UI during the last repaint
+	Scenes nextScene = Scenes::NONE;
 	
 	// RayGUI component states
 	// Button component: Uses return value, no state variable needed
@@ -34,6 +52,9 @@ private:
 	bool showMessageBox;
 	bool messageBoxOkClicked;
 
+	void invalidate_ui_on_input();
+	void draw_ui();
+
 public:
 	TitleScene();
 	~TitleScene();
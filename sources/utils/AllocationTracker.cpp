@@ -0,0 +1,250 @@
+#ifdef TRACK_ALLOCATIONS
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationTracker.hpp"
+
+// Note that nothing in this file may allocate through operator new, since
+// that would recurse into the tracker. Logging is done with plain fprintf.
+
+namespace
+{
+    std::atomic<size_t> frame_allocations{0};
+    std::atomic<size_t> frame_bytes{0};
+    std::atomic<size_t> frame_frees{0};
+
+    // per-thread running totals, used by scopes so that worker threads don't
+    // get attributed to whatever scope the main thread happens to be in
+    thread_local AllocationTracker::Counters thread_totals;
+
+    size_t frame_budget = 0;
+    bool budget_armed = false;
+    int warmup_frames_left = 0;
+    size_t violations = 0;
+    size_t frame_number = 0;
+
+    bool is_budget_enforced()
+    {
+        return budget_armed && warmup_frames_left <= 0;
+    }
+
+    void *allocate(size_t size)
+    {
+        void *ptr = std::malloc(size == 0 ? 1 : size);
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        AllocationTracker::record_allocation(size);
+        return ptr;
+    }
+
+    void *allocate_aligned(size_t size, std::align_val_t alignment)
+    {
+        auto align = static_cast<size_t>(alignment);
+        // aligned_alloc requires the size to be a multiple of the alignment
+        size_t padded_size = ((size + align - 1) / align) * align;
+
+#if defined(_MSC_VER)
+        void *ptr = _aligned_malloc(padded_size, align);
+#else
+        void *ptr = std::aligned_alloc(align, padded_size == 0 ? align : padded_size);
+#endif
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        AllocationTracker::record_allocation(size);
+        return ptr;
+    }
+
+    void deallocate(void *ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        AllocationTracker::record_free();
+        std::free(ptr);
+    }
+
+    void deallocate_aligned(void *ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        AllocationTracker::record_free();
+#if defined(_MSC_VER)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+namespace AllocationTracker
+{
+    void record_allocation(size_t bytes)
+    {
+        frame_allocations.fetch_add(1, std::memory_order_relaxed);
+        frame_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        thread_totals.allocations += 1;
+        thread_totals.bytes += bytes;
+    }
+
+    void record_free()
+    {
+        frame_frees.fetch_add(1, std::memory_order_relaxed);
+        thread_totals.frees += 1;
+    }
+
+    void begin_frame()
+    {
+        frame_allocations.store(0, std::memory_order_relaxed);
+        frame_bytes.store(0, std::memory_order_relaxed);
+        frame_frees.store(0, std::memory_order_relaxed);
+    }
+
+    Counters end_frame()
+    {
+        Counters frame{
+            .allocations = frame_allocations.load(std::memory_order_relaxed),
+            .bytes = frame_bytes.load(std::memory_order_relaxed),
+            .frees = frame_frees.load(std::memory_order_relaxed),
+        };
+
+        frame_number++;
+
+        if (is_budget_enforced() && frame.allocations > frame_budget)
+        {
+            violations++;
+            std::fprintf(stderr,
+                         "[AllocationTracker] frame %zu went over budget: %zu allocations (%zu bytes), budget is %zu\n",
+                         frame_number, frame.allocations, frame.bytes, frame_budget);
+        }
+
+        if (warmup_frames_left > 0)
+        {
+            warmup_frames_left--;
+        }
+
+        return frame;
+    }
+
+    void set_frame_budget(size_t allocations)
+    {
+        frame_budget = allocations;
+    }
+
+    void arm_budget(int warmup_frames)
+    {
+        budget_armed = true;
+        warmup_frames_left = warmup_frames;
+    }
+
+    void disarm_budget()
+    {
+        budget_armed = false;
+    }
+
+    size_t budget_violations()
+    {
+        return violations;
+    }
+
+    Scope::Scope(const char *name) : name(name), start(thread_totals)
+    {
+    }
+
+    Scope::~Scope()
+    {
+        auto scope = counters();
+        if (is_budget_enforced() && scope.allocations > frame_budget)
+        {
+            std::fprintf(stderr,
+                         "[AllocationTracker] scope '%s' allocated %zu times (%zu bytes) in frame %zu\n",
+                         name, scope.allocations, scope.bytes, frame_number + 1);
+        }
+    }
+
+    Counters Scope::counters() const
+    {
+        return {
+            .allocations = thread_totals.allocations - start.allocations,
+            .bytes = thread_totals.bytes - start.bytes,
+            .frees = thread_totals.frees - start.frees,
+        };
+    }
+}
+
+// Box2D allocation hooks, see physics/box2d_settings/b2_user_settings.h
+void *b2TrackedAlloc(int size)
+{
+    void *ptr = std::malloc(size);
+    AllocationTracker::record_allocation(size);
+    return ptr;
+}
+
+void b2TrackedFree(void *ptr)
+{
+    if (ptr != nullptr)
+    {
+        AllocationTracker::record_free();
+    }
+    std::free(ptr);
+}
+
+//==================================================================================
+// Global allocation operators
+//==================================================================================
+
+void *operator new(size_t size) { return allocate(size); }
+void *operator new[](size_t size) { return allocate(size); }
+void *operator new(size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+void *operator new[](size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { deallocate_aligned(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { deallocate_aligned(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { deallocate_aligned(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { deallocate_aligned(ptr); }
+
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Opt-in heap allocation counters. When the project is configured with
+ * `-DTRACK_ALLOCATIONS=ON` the global operator new/delete (and Box2D's
+ * b2Alloc/b2Free) report every allocation here, so we can see how many
+ * allocations and bytes each frame and each tracked scope performs.
+ *
+ * When tracking is disabled every function in here is an empty inline so it
+ * can be left in hot paths at no cost.
+ */
+namespace AllocationTracker
+{
+    struct Counters
+    {
+        size_t allocations = 0;
+        size_t bytes = 0;
+        size_t frees = 0;
+    };
+
+#ifdef TRACK_ALLOCATIONS
+    void record_allocation(size_t bytes);
+    void record_free();
+
+    // Frame counters. `end_frame` returns what happened since `begin_frame`
+    // and checks it against the frame budget once we're past the warmup.
+    void begin_frame();
+    Counters end_frame();
+
+    // Maximum number of allocations a steady-state frame is allowed to do
+    void set_frame_budget(size_t allocations);
+
+    // Frames that are allowed to allocate freely after the budget is armed
+    // (level load, first contacts, lazily grown containers, etc.)
+    void arm_budget(int warmup_frames);
+    void disarm_budget();
+
+    // Number of frames that went over the budget since it was armed
+    size_t budget_violations();
+
+    /**
+     * Counts the allocations done by the current thread while it is alive and
+     * reports them against the budget when it goes out of scope. `name` must
+     * be a string literal since we don't want the tracker itself to allocate.
+     */
+    class Scope
+    {
+    private:
+        const char *name;
+        Counters start;
+
+    public:
+        explicit Scope(const char *name);
+        ~Scope();
+
+        Counters counters() const;
+    };
+#else
+    inline void record_allocation(size_t) {}
+    inline void record_free() {}
+
+    inline void begin_frame() {}
+    inline Counters end_frame() { return {}; }
+
+    inline void set_frame_budget(size_t) {}
+    inline void arm_budget(int) {}
+    inline void disarm_budget() {}
+    inline size_t budget_violations() { return 0; }
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char *) {}
+
+        Counters counters() const { return {}; }
+    };
+#endif
+}
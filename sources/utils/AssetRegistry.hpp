@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#if defined(PLATFORM_WEB)
+#define ASSET_SHADER_DIR "shaders/glsl100/"
+#else
+#define ASSET_SHADER_DIR "shaders/glsl330/"
+#endif
+
+/**
+ * Every asset the code loads by a fixed name, with its path relative to the
+ * assets folder. cmake/CheckAssets.cmake reads this list to check that each
+ * file exists (in both shader dirs for shaders) as part of the build, so keep
+ * one `ASSET(ID, "path")` entry per line.
+ *
+ * Assets referenced by LDtk levels are only known at runtime and still go
+ * through AppConstants::GetAssetPath.
+ */
+#define ASSET_LIST(ASSET) \
+    ASSET(WORLD, "world.ldtk") \
+    ASSET(TITLE_TEXTURE, "test.png") \
+    ASSET(PLAYER_SPRITE, "dinoCharactersVersion1.1/sheets/DinoSprites - vita.png") \
+    ASSET(SPIKES_SPRITE, "Pixel Adventure 1/Traps/Spikes/Idle.png") \
+    ASSET(SAW_SPRITE, "Pixel Adventure 1/Traps/Saw/On (38x38).png") \
+    ASSET(PLATFORM_SPRITE, "Pixel Adventure 1/Traps/Platforms/Grey Off.png") \
+    ASSET(PATROL_SPRITE, "Pixel Adventure 1/Main Characters/Mask Dude/Run (32x32).png") \
+    ASSET(TILEMAP_SHADER, ASSET_SHADER_DIR "tilemap.fs") \
+    ASSET(CRT_SHADER, ASSET_SHADER_DIR "crt.fs") \
+    ASSET(BLOOM_SHADER, ASSET_SHADER_DIR "bloom.fs")
+
+enum class AssetId
+{
+#define ASSET_ID(id, name) id,
+    ASSET_LIST(ASSET_ID)
+#undef ASSET_ID
+};
+
+namespace AssetRegistry
+{
+#define ASSET_COUNT(id, name) +1
+    constexpr size_t Count = 0 ASSET_LIST(ASSET_COUNT);
+#undef ASSET_COUNT
+
+    // All of these are built by string literal concatenation, so looking an
+    // asset up is an array index with no string building or static init
+
+#define ASSET_NAME(id, name) name,
+    constexpr std::array<std::string_view, Count> Names = {ASSET_LIST(ASSET_NAME)};
+#undef ASSET_NAME
+
+#define ASSET_PATH(id, name) ASSETS_PATH name,
+    constexpr std::array<const char *, Count> Paths = {ASSET_LIST(ASSET_PATH)};
+#undef ASSET_PATH
+
+    // Where the asset cooker writes the pre-decoded version, see CookedTexture
+#define ASSET_COOKED_PATH(id, name) ASSETS_PATH "cooked/" name ".rtex",
+    constexpr std::array<const char *, Count> CookedPaths = {ASSET_LIST(ASSET_COOKED_PATH)};
+#undef ASSET_COOKED_PATH
+
+    // Path relative to the assets folder
+    constexpr std::string_view get_name(AssetId id)
+    {
+        return Names[(size_t)id];
+    }
+
+    constexpr const char *get_path(AssetId id)
+    {
+        return Paths[(size_t)id];
+    }
+
+    constexpr const char *get_cooked_path(AssetId id)
+    {
+        return CookedPaths[(size_t)id];
+    }
+
+    constexpr bool has_unique_names()
+    {
+        for (size_t i = 0; i < Count; i++)
+        {
+            for (size_t j = i + 1; j < Count; j++)
+            {
+                if (Names[i] == Names[j])
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(has_unique_names(), "The same asset is registered twice");
+}
@@ -0,0 +1,202 @@
+#include <string>
+
+#include "AssetStreamer.hpp"
+
+#if defined(PLATFORM_WEB)
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/stat.h>
+#include <emscripten/fetch.h>
+
+#include <raylib.h>
+
+#include <Constants.hpp>
+#include <utils/DebugUtils.hpp>
+
+namespace
+{
+	enum class FetchState
+	{
+		PENDING,
+		DONE,
+		FAILED,
+	};
+
+	// level name -> assets it references, relative to the assets folder
+	std::unordered_map<std::string, std::vector<std::string>> manifest;
+	bool manifestLoaded = false;
+
+	std::unordered_map<std::string, FetchState> fetches;
+
+	void load_manifest()
+	{
+		manifestLoaded = true;
+
+		char *text = LoadFileText(AppConstants::GetAssetPath("asset_manifest.txt").c_str());
+		if (text == nullptr)
+		{
+			DebugUtils::println("No asset manifest found, assuming every asset is preloaded");
+			return;
+		}
+
+		std::istringstream lines(text);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			auto separator = line.find('\t');
+			if (separator == std::string::npos)
+			{
+				continue;
+			}
+
+			manifest[line.substr(0, separator)].push_back(line.substr(separator + 1));
+		}
+
+		UnloadFileText(text);
+	}
+
+	void make_parent_directories(const std::string &path)
+	{
+		for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1))
+		{
+			mkdir(path.substr(0, slash).c_str(), 0777);
+		}
+	}
+
+	std::string url_encode_spaces(const std::string &path)
+	{
+		std::string encoded;
+		for (char c : path)
+		{
+			if (c == ' ')
+			{
+				encoded += "%20";
+			}
+			else
+			{
+				encoded += c;
+			}
+		}
+		return encoded;
+	}
+
+	void on_fetch_success(emscripten_fetch_t *fetch)
+	{
+		auto *asset = static_cast<std::string *>(fetch->userData);
+		auto path = AppConstants::GetAssetPath(*asset);
+
+		make_parent_directories(path);
+		FILE *file = fopen(path.c_str(), "wb");
+		if (file != nullptr)
+		{
+			fwrite(fetch->data, 1, fetch->numBytes, file);
+			fclose(file);
+			fetches[*asset] = FetchState::DONE;
+		}
+		else
+		{
+			fetches[*asset] = FetchState::FAILED;
+		}
+
+		DebugUtils::println("Fetched asset {} ({} bytes)", *asset, fetch->numBytes);
+
+		delete asset;
+		emscripten_fetch_close(fetch);
+	}
+
+	void on_fetch_error(emscripten_fetch_t *fetch)
+	{
+		auto *asset = static_cast<std::string *>(fetch->userData);
+		DebugUtils::println("Failed to fetch asset {} (HTTP {})", *asset, fetch->status);
+
+		fetches[*asset] = FetchState::FAILED;
+
+		delete asset;
+		emscripten_fetch_close(fetch);
+	}
+
+	void start_fetch(const std::string &asset)
+	{
+		fetches[asset] = FetchState::PENDING;
+
+		emscripten_fetch_attr_t attr;
+		emscripten_fetch_attr_init(&attr);
+		strcpy(attr.requestMethod, "GET");
+		attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
+		attr.userData = new std::string(asset);
+		attr.onsuccess = on_fetch_success;
+		attr.onerror = on_fetch_error;
+
+		// assets are served from the `assets` folder next to the html file
+		emscripten_fetch(&attr, url_encode_spaces("assets/" + asset).c_str());
+	}
+}
+
+namespace AssetStreamer
+{
+	void request_level(const std::string &levelName)
+	{
+		if (!manifestLoaded)
+		{
+			load_manifest();
+		}
+
+		for (auto &&asset : manifest[levelName])
+		{
+			auto fetch = fetches.find(asset);
+			bool available = FileExists(AppConstants::GetAssetPath(asset).c_str());
+
+			// failed fetches are retried every time the level is requested again
+			if (!available && (fetch == fetches.end() || fetch->second == FetchState::FAILED))
+			{
+				start_fetch(asset);
+			}
+		}
+	}
+
+	bool is_level_ready(const std::string &levelName)
+	{
+		if (!manifestLoaded)
+		{
+			load_manifest();
+		}
+
+		for (auto &&asset : manifest[levelName])
+		{
+			auto fetch = fetches.find(asset);
+			if (fetch != fetches.end() && fetch->second != FetchState::DONE)
+			{
+				return false;
+			}
+
+			if (fetch == fetches.end() && !FileExists(AppConstants::GetAssetPath(asset).c_str()))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+#else
+
+namespace AssetStreamer
+{
+	void request_level(const std::string &)
+	{
+	}
+
+	bool is_level_ready(const std::string &)
+	{
+		return true;
+	}
+}
+
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+/**
+ * On the web build only a small core set of assets is preloaded, everything a
+ * level needs is fetched on demand using the manifest generated from
+ * `world.ldtk` at build time (see cmake/AssetManifest.cmake). Fetched files
+ * are written into the in-memory filesystem, so once a level is ready the
+ * usual `LoadTexture(AppConstants::GetAssetPath(...))` calls just work.
+ *
+ * On every other platform all assets are on disk already, so levels are
+ * always ready.
+ */
+namespace AssetStreamer
+{
+    // Starts fetching whatever the level needs and isn't available yet
+    void request_level(const std::string &levelName);
+
+    bool is_level_ready(const std::string &levelName);
+}
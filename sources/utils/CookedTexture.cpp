@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <raylib.h>
+
+#include <Constants.hpp>
+
+#include "CookedTexture.hpp"
+
+namespace
+{
+	constexpr uint32_t Magic = 0x58455452; // "RTEX" in little endian
+	constexpr uint32_t Version = 1;
+
+	enum Compression : uint32_t
+	{
+		COMPRESSION_NONE = 0,
+		COMPRESSION_DEFLATE = 1,
+	};
+
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		int32_t width;
+		int32_t height;
+		int32_t mipmaps;
+		int32_t format; // raylib PixelFormat, leaves room for GPU compressed formats
+		uint32_t compression;
+		uint32_t dataSize;	  // size of the decoded pixel data, all mip levels included
+		uint32_t payloadSize; // size of what follows the header in the file
+	};
+
+	// total size of the pixel data of an image including its mip chain
+	int get_data_size(int width, int height, int mipmaps, int format)
+	{
+		int size = 0;
+		for (int i = 0; i < mipmaps; i++)
+		{
+			size += GetPixelDataSize(width, height, format);
+			width = width > 1 ? width / 2 : 1;
+			height = height > 1 ? height / 2 : 1;
+		}
+		return size;
+	}
+
+	// cooked files are built by hand (`cook-assets`), so one older than its
+	// source would hide the edit
+	bool is_cooked_usable(const char *cookedPath, const char *sourcePath)
+	{
+		if (!FileExists(cookedPath))
+		{
+			return false;
+		}
+
+		// builds may ship the cooked file without its source
+		if (FileExists(sourcePath) && GetFileModTime(cookedPath) < GetFileModTime(sourcePath))
+		{
+			TraceLog(LOG_WARNING, "%s is older than %s, loading the source until assets are cooked again", cookedPath, sourcePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	Image load_image_from_paths(const char *cookedPath, const char *sourcePath)
+	{
+		if (is_cooked_usable(cookedPath, sourcePath))
+		{
+			Image image = CookedTexture::load_image(cookedPath);
+			if (image.data != nullptr)
+			{
+				return image;
+			}
+		}
+
+		return LoadImage(sourcePath);
+	}
+
+	Texture2D load_texture_from_paths(const char *cookedPath, const char *sourcePath)
+	{
+		if (!is_cooked_usable(cookedPath, sourcePath))
+		{
+			return LoadTexture(sourcePath);
+		}
+
+		Image image = CookedTexture::load_image(cookedPath);
+		if (image.data == nullptr)
+		{
+			return LoadTexture(sourcePath);
+		}
+
+		Texture2D texture = LoadTextureFromImage(image);
+		UnloadImage(image);
+		return texture;
+	}
+}
+
+namespace CookedTexture
+{
+	std::string get_cooked_name(const std::string &assetName)
+	{
+		return "cooked/" + assetName + ".rtex";
+	}
+
+	bool save(const std::string &fileName, const Image &image, bool compress)
+	{
+		Header header = {
+			.magic = Magic,
+			.version = Version,
+			.width = image.width,
+			.height = image.height,
+			.mipmaps = image.mipmaps,
+			.format = image.format,
+			.compression = compress ? COMPRESSION_DEFLATE : COMPRESSION_NONE,
+			.dataSize = (uint32_t)get_data_size(image.width, image.height, image.mipmaps, image.format),
+			.payloadSize = 0,
+		};
+
+		unsigned char *payload = (unsigned char *)image.data;
+		int compressedSize = 0;
+		if (compress)
+		{
+			payload = CompressData(payload, header.dataSize, &compressedSize);
+			header.payloadSize = compressedSize;
+		}
+		else
+		{
+			header.payloadSize = header.dataSize;
+		}
+
+		std::vector<unsigned char> file(sizeof(Header) + header.payloadSize);
+		std::memcpy(file.data(), &header, sizeof(Header));
+		std::memcpy(file.data() + sizeof(Header), payload, header.payloadSize);
+
+		if (compress)
+		{
+			MemFree(payload);
+		}
+
+		return SaveFileData(fileName.c_str(), file.data(), (int)file.size());
+	}
+
+	Image load_image(const std::string &fileName)
+	{
+		Image image = {};
+
+		int fileSize = 0;
+		unsigned char *file = LoadFileData(fileName.c_str(), &fileSize);
+		if (file == nullptr)
+		{
+			return image;
+		}
+
+		Header header;
+		std::memcpy(&header, file, std::min<size_t>(sizeof(Header), fileSize));
+
+		bool valid = fileSize >= (int)sizeof(Header) &&
+					 header.magic == Magic &&
+					 header.version == Version &&
+					 fileSize - sizeof(Header) >= header.payloadSize;
+
+		if (!valid)
+		{
+			TraceLog(LOG_WARNING, "COOKED: [%s] Invalid cooked texture", fileName.c_str());
+			UnloadFileData(file);
+			return image;
+		}
+
+		unsigned char *payload = file + sizeof(Header);
+		if (header.compression == COMPRESSION_DEFLATE)
+		{
+			int dataSize = 0;
+			image.data = DecompressData(payload, header.payloadSize, &dataSize);
+			if (image.data != nullptr && (uint32_t)dataSize != header.dataSize)
+			{
+				TraceLog(LOG_WARNING, "COOKED: [%s] Decompressed size doesn't match", fileName.c_str());
+				MemFree(image.data);
+				image.data = nullptr;
+			}
+		}
+		else
+		{
+			image.data = MemAlloc(header.dataSize);
+			std::memcpy(image.data, payload, header.dataSize);
+		}
+
+		UnloadFileData(file);
+
+		if (image.data != nullptr)
+		{
+			image.width = header.width;
+			image.height = header.height;
+			image.mipmaps = header.mipmaps;
+			image.format = header.format;
+		}
+
+		return image;
+	}
+
+	Image load_asset_image(const std::string &assetName)
+	{
+		auto cookedPath = AppConstants::GetAssetPath(get_cooked_name(assetName));
+		return load_image_from_paths(cookedPath.c_str(), AppConstants::GetAssetPath(assetName).c_str());
+	}
+
+	Texture2D load_asset_texture(const std::string &assetName)
+	{
+		auto cookedPath = AppConstants::GetAssetPath(get_cooked_name(assetName));
+		return load_texture_from_paths(cookedPath.c_str(), AppConstants::GetAssetPath(assetName).c_str());
+	}
+
+	Texture2D load_asset_texture(AssetId asset)
+	{
+		return load_texture_from_paths(AssetRegistry::get_cooked_path(asset), AssetRegistry::get_path(asset));
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+#include <raylib.h>
+
+#include "AssetRegistry.hpp"
+
+/**
+ * Pre-cooked texture format written by the asset cooker (tools/asset_cooker)
+ * and read by the game. A cooked texture is the already decoded image with
+ * its whole mip chain, optionally DEFLATE compressed, so loading one is a
+ * file read (plus inflate) and a GPU upload instead of a PNG decode.
+ *
+ * Cooked files live in `assets/cooked/` and are named after the original
+ * asset with `.rtex` appended.
+ */
+namespace CookedTexture
+{
+    // Path (relative to the assets folder) the cooked version of `assetName` is written to
+    std::string get_cooked_name(const std::string &assetName);
+
+    bool save(const std::string &fileName, const Image &image, bool compress);
+
+    // Returns an image with `data == nullptr` if the file is missing or invalid
+    Image load_image(const std::string &fileName);
+
+    // Load the cooked version of an asset when it exists, otherwise decode
+    // the original file. `assetName` is relative to the assets folder.
+    Image load_asset_image(const std::string &assetName);
+    Texture2D load_asset_texture(const std::string &assetName);
+
+    // Same for registered assets, whose paths are known at compile time
+    Texture2D load_asset_texture(AssetId asset);
+}
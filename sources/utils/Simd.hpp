@@ -0,0 +1,159 @@
+#pragma once
+
+/**
+ * Minimal portable 4-wide float SIMD layer. Picks SSE on x86, NEON on ARM and
+ * WebAssembly SIMD128 when emscripten is building with -msimd128, and falls
+ * back to plain scalar code everywhere else. Only the handful of operations
+ * the particle kernels need are implemented.
+ */
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SIMD_SSE 1
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#define SIMD_WASM 1
+#include <wasm_simd128.h>
+#else
+#define SIMD_SCALAR 1
+#endif
+
+namespace Simd
+{
+    // Number of floats processed per operation
+    constexpr int Width = 4;
+
+    // Required alignment (in bytes) of pointers passed to load/store
+    constexpr int Alignment = 16;
+
+    constexpr const char *backend_name()
+    {
+#if defined(SIMD_SSE)
+        return "sse";
+#elif defined(SIMD_NEON)
+        return "neon";
+#elif defined(SIMD_WASM)
+        return "wasm-simd128";
+#else
+        return "scalar";
+#endif
+    }
+
+    struct float4
+    {
+#if defined(SIMD_SSE)
+        __m128 v;
+#elif defined(SIMD_NEON)
+        float32x4_t v;
+#elif defined(SIMD_WASM)
+        v128_t v;
+#else
+        float v[4];
+#endif
+    };
+
+    inline float4 load(const float *ptr)
+    {
+#if defined(SIMD_SSE)
+        return {_mm_load_ps(ptr)};
+#elif defined(SIMD_NEON)
+        return {vld1q_f32(ptr)};
+#elif defined(SIMD_WASM)
+        return {wasm_v128_load(ptr)};
+#else
+        return {{ptr[0], ptr[1], ptr[2], ptr[3]}};
+#endif
+    }
+
+    inline void store(float *ptr, float4 a)
+    {
+#if defined(SIMD_SSE)
+        _mm_store_ps(ptr, a.v);
+#elif defined(SIMD_NEON)
+        vst1q_f32(ptr, a.v);
+#elif defined(SIMD_WASM)
+        wasm_v128_store(ptr, a.v);
+#else
+        for (int i = 0; i < 4; i++)
+        {
+            ptr[i] = a.v[i];
+        }
+#endif
+    }
+
+    inline float4 set1(float value)
+    {
+#if defined(SIMD_SSE)
+        return {_mm_set1_ps(value)};
+#elif defined(SIMD_NEON)
+        return {vdupq_n_f32(value)};
+#elif defined(SIMD_WASM)
+        return {wasm_f32x4_splat(value)};
+#else
+        return {{value, value, value, value}};
+#endif
+    }
+
+    inline float4 add(float4 a, float4 b)
+    {
+#if defined(SIMD_SSE)
+        return {_mm_add_ps(a.v, b.v)};
+#elif defined(SIMD_NEON)
+        return {vaddq_f32(a.v, b.v)};
+#elif defined(SIMD_WASM)
+        return {wasm_f32x4_add(a.v, b.v)};
+#else
+        return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+#endif
+    }
+
+    inline float4 sub(float4 a, float4 b)
+    {
+#if defined(SIMD_SSE)
+        return {_mm_sub_ps(a.v, b.v)};
+#elif defined(SIMD_NEON)
+        return {vsubq_f32(a.v, b.v)};
+#elif defined(SIMD_WASM)
+        return {wasm_f32x4_sub(a.v, b.v)};
+#else
+        return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+#endif
+    }
+
+    inline float4 mul(float4 a, float4 b)
+    {
+#if defined(SIMD_SSE)
+        return {_mm_mul_ps(a.v, b.v)};
+#elif defined(SIMD_NEON)
+        return {vmulq_f32(a.v, b.v)};
+#elif defined(SIMD_WASM)
+        return {wasm_f32x4_mul(a.v, b.v)};
+#else
+        return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+#endif
+    }
+
+    // a * b + c, not fused so results match the scalar kernels bit for bit
+    inline float4 mul_add(float4 a, float4 b, float4 c)
+    {
+        return add(mul(a, b), c);
+    }
+
+    inline float4 max(float4 a, float4 b)
+    {
+#if defined(SIMD_SSE)
+        return {_mm_max_ps(a.v, b.v)};
+#elif defined(SIMD_NEON)
+        return {vmaxq_f32(a.v, b.v)};
+#elif defined(SIMD_WASM)
+        return {wasm_f32x4_pmax(a.v, b.v)};
+#else
+        return {{a.v[0] > b.v[0] ? a.v[0] : b.v[0],
+                 a.v[1] > b.v[1] ? a.v[1] : b.v[1],
+                 a.v[2] > b.v[2] ? a.v[2] : b.v[2],
+                 a.v[3] > b.v[3] ? a.v[3] : b.v[3]}};
+#endif
+    }
+}
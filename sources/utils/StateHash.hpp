@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * 64-bit FNV-1a hash, used to fingerprint simulation state every tick. Values
+ * are hashed by their bit pattern, so two states only hash the same if they
+ * are bit-for-bit identical (e.g. -0.0f and 0.0f hash differently).
+ */
+class StateHash
+{
+private:
+    uint64_t value = 0xCBF29CE484222325ull;
+
+public:
+    void add_bytes(const void *data, size_t size)
+    {
+        auto bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            value ^= bytes[i];
+            value *= 0x100000001B3ull;
+        }
+    }
+
+    template <typename T>
+    void add(const T &data)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only plain values can be hashed by their bytes");
+        add_bytes(&data, sizeof(T));
+    }
+
+    uint64_t get() const
+    {
+        return value;
+    }
+};
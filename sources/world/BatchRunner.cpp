@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <LDtkLoader/World.hpp>
+
+#include "BatchRunner.hpp"
+#include "Simulation.hpp"
+
+namespace
+{
+	// input only changes every few ticks, like a (very erratic) human would
+	constexpr int TicksPerDecision = 10;
+
+	uint32_t mix_bits(uint32_t value)
+	{
+		value ^= value >> 16;
+		value *= 0x7FEB352Du;
+		value ^= value >> 15;
+		value *= 0x846CA68Bu;
+		value ^= value >> 16;
+		return value;
+	}
+
+	BatchRunner::InstanceResult run_instance(const ldtk::World *ldtkWorld,
+											 const BatchRunner::Options &options,
+											 const BatchRunner::InputScript &script,
+											 int instance)
+	{
+		int levelCount = (int)ldtkWorld->allLevels().size();
+		int level = options.level >= 0 ? options.level : instance % levelCount;
+
+		Simulation simulation;
+		simulation.load_level(&ldtkWorld->getLevel(level));
+
+		BatchRunner::InstanceResult result{.instance = instance, .level = level};
+
+		auto player = simulation.get_player();
+		for (int tick = 0; tick < options.ticks; tick++)
+		{
+			simulation.step(script(instance, tick));
+			result.jumps += player->has_jumped();
+		}
+
+		result.finalPosition = player->get_position();
+		result.respawns = player->get_respawn_count();
+		return result;
+	}
+}
+
+int BatchRunner::resolve_thread_count(const Options &options)
+{
+	if (options.threadCount > 0)
+	{
+		return options.threadCount;
+	}
+
+	// hardware_concurrency may return 0 if it can't tell
+	return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+std::vector<BatchRunner::InstanceResult> BatchRunner::run(const ldtk::World *ldtkWorld, const Options &options, const InputScript &script)
+{
+	std::vector<InstanceResult> results(options.instanceCount);
+	std::atomic<int> nextInstance = 0;
+
+	// workers pull instances one at a time, so a slow level doesn't leave
+	// the other threads idle at the end of the batch. Every instance has its
+	// own b2World, the only state box2d shares between worlds are its
+	// profiling counters, which the build makes thread_local.
+	auto worker = [&]()
+	{
+		for (int instance = nextInstance++; instance < options.instanceCount; instance = nextInstance++)
+		{
+			results[instance] = run_instance(ldtkWorld, options, script, instance);
+		}
+	};
+
+	int threadCount = std::min(resolve_thread_count(options), std::max(options.instanceCount, 1));
+
+	std::vector<std::thread> threads;
+	for (int i = 1; i < threadCount; i++)
+	{
+		threads.emplace_back(worker);
+	}
+
+	// the calling thread works too instead of just waiting
+	worker();
+
+	for (auto &&thread : threads)
+	{
+		thread.join();
+	}
+
+	return results;
+}
+
+PlayerInput BatchRunner::random_input(int instance, int tick)
+{
+	int decision = tick / TicksPerDecision;
+	uint32_t bits = mix_bits(uint32_t(instance) * 0x9E3779B9u ^ mix_bits(uint32_t(decision)));
+
+	return {
+		.left = (bits & 3) == 0,
+		.right = (bits & 3) >= 2,
+		// jump at the start of some decisions only, holding it does nothing
+		.jump = tick % TicksPerDecision == 0 && (bits & 4) != 0,
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <raylib.h>
+#include <LDtkLoader/World.hpp>
+
+#include "../entities/Player/Player.hpp"
+
+/**
+ * Runs many headless Simulations at once, spread over a pool of threads. Used
+ * for automated playtesting and level validation: every instance plays one of
+ * the world's levels for a fixed number of ticks, driven by an input script,
+ * and reports where the player ended up.
+ *
+ * Instances share nothing but the (read only) LDtk world, so throughput
+ * scales with the number of cores.
+ */
+namespace BatchRunner
+{
+    // Input of instance `instance` on tick `tick`. Called concurrently from
+    // several threads, so it must not touch shared mutable state.
+    using InputScript = std::function<PlayerInput(int instance, int tick)>;
+
+    struct Options
+    {
+        int instanceCount = 1;
+        int ticks = 60 * 60;
+
+        // 0 uses every hardware thread
+        int threadCount = 0;
+
+        // instance `i` plays level `i % levelCount`, or this level if not -1
+        int level = -1;
+    };
+
+    struct InstanceResult
+    {
+        int instance = 0;
+        int level = 0;
+
+        // player position in world pixels at the end of the run
+        Vector2 finalPosition{};
+        int jumps = 0;
+        int respawns = 0;
+    };
+
+    // Blocks until every instance is done, results are ordered by instance
+    std::vector<InstanceResult> run(const ldtk::World *ldtkWorld, const Options &options, const InputScript &script);
+
+    // Deterministic pseudo random button mashing, seeded by the instance
+    PlayerInput random_input(int instance, int tick);
+
+    // Number of threads `options.threadCount` resolves to
+    int resolve_thread_count(const Options &options);
+}
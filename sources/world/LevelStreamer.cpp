@@ -0,0 +1,302 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/World.hpp>
+
+#include <Constants.hpp>
+#include <utils/AllocationTracker.hpp>
+#include <utils/AssetStreamer.hpp>
+#include <utils/CookedTexture.hpp>
+#include <utils/DebugUtils.hpp>
+
+#include "LevelStreamer.hpp"
+#include "../physics/LevelColliders.hpp"
+
+namespace
+{
+	float distance_to_rect(Vector2 point, Rectangle rect)
+	{
+		float dx = std::max({rect.x - point.x, 0.0f, point.x - (rect.x + rect.width)});
+		float dy = std::max({rect.y - point.y, 0.0f, point.y - (rect.y + rect.height)});
+		return std::sqrt(dx * dx + dy * dy);
+	}
+
+	// deferred bakes (see load_level) run synchronously as soon as we ask for them
+	bool is_ready(const std::future<Image> &future)
+	{
+		return future.wait_for(std::chrono::seconds(0)) != std::future_status::timeout;
+	}
+}
+
+LevelStreamer::LevelStreamer(const ldtk::World *ldtkWorld, b2World *physicsWorld, ActorSystem *actors)
+	: ldtkWorld(ldtkWorld), physicsWorld(physicsWorld), actors(actors)
+{
+	bool first = true;
+	for (auto &&level : ldtkWorld->allLevels())
+	{
+		auto rect = get_level_rect(&level);
+		if (first)
+		{
+			worldBounds = rect;
+			first = false;
+			continue;
+		}
+
+		float right = std::max(worldBounds.x + worldBounds.width, rect.x + rect.width);
+		float bottom = std::max(worldBounds.y + worldBounds.height, rect.y + rect.height);
+		worldBounds.x = std::min(worldBounds.x, rect.x);
+		worldBounds.y = std::min(worldBounds.y, rect.y);
+		worldBounds.width = right - worldBounds.x;
+		worldBounds.height = bottom - worldBounds.y;
+	}
+}
+
+LevelStreamer::~LevelStreamer()
+{
+	for (auto &&[level, streamedLevel] : loadedLevels)
+	{
+		unload_level(streamedLevel);
+	}
+	loadedLevels.clear();
+
+	// futures returned by std::async block until their task is done when destroyed,
+	// so by the time we get here every bake has finished
+	for (auto &&bake : retiredBakes)
+	{
+		UnloadImage(bake.get());
+	}
+}
+
+bool LevelStreamer::update(Vector2 focus)
+{
+	bool changed = false;
+
+	for (auto &&level : ldtkWorld->allLevels())
+	{
+		auto rect = get_level_rect(&level);
+		auto distance = distance_to_rect(focus, rect);
+		auto loaded = loadedLevels.find(&level);
+
+		if (loaded == loadedLevels.end() && distance <= StreamingConstants::LoadDistance)
+		{
+			// on the web the level's assets may still be downloading, try again next update
+			AssetStreamer::request_level(level.name);
+			if (AssetStreamer::is_level_ready(level.name))
+			{
+				load_level(&level);
+				changed = true;
+			}
+		}
+		else if (loaded != loadedLevels.end() && distance > StreamingConstants::UnloadDistance)
+		{
+			unload_level(loaded->second);
+			loadedLevels.erase(loaded);
+			changed = true;
+		}
+	}
+
+	collect_finished_bakes();
+	return changed;
+}
+
+void LevelStreamer::draw() const
+{
+	for (auto &&[level, streamedLevel] : loadedLevels)
+	{
+		if (streamedLevel.texture.id != 0)
+		{
+			DrawTextureV(streamedLevel.texture, {streamedLevel.rect.x, streamedLevel.rect.y}, WHITE);
+		}
+	}
+}
+
+Rectangle LevelStreamer::get_world_bounds() const
+{
+	return worldBounds;
+}
+
+size_t LevelStreamer::loaded_level_count() const
+{
+	return loadedLevels.size();
+}
+
+const CollisionGrid *LevelStreamer::get_collision_grid_at(Vector2 position) const
+{
+	for (auto &&[level, streamedLevel] : loadedLevels)
+	{
+		if (CheckCollisionPointRec(position, streamedLevel.rect))
+		{
+			return &streamedLevel.grid;
+		}
+	}
+
+	return nullptr;
+}
+
+Rectangle LevelStreamer::get_level_rect(const ldtk::Level *level)
+{
+	return {
+		(float)level->position.x,
+		(float)level->position.y,
+		(float)level->size.x,
+		(float)level->size.y,
+	};
+}
+
+void LevelStreamer::load_level(const ldtk::Level *level)
+{
+	DebugUtils::println("Streaming in level {}", level->name);
+
+	auto &streamedLevel = loadedLevels[level];
+	streamedLevel.level = level;
+	streamedLevel.rect = get_level_rect(level);
+	streamedLevel.bodies = LevelColliders::create(level, physicsWorld, {streamedLevel.rect.x, streamedLevel.rect.y});
+	streamedLevel.grid = CollisionGrid::from_level(level, {streamedLevel.rect.x, streamedLevel.rect.y});
+
+	// elements of the map keep their address until erased, so the grid can be
+	// handed out for as long as the level is loaded
+	actors->add_level(level, &streamedLevel.grid, {streamedLevel.rect.x, streamedLevel.rect.y});
+
+	// image decoding and composition are CPU only so they can happen on a worker,
+	// the upload to the GPU happens on the main thread in collect_finished_bakes
+#if defined(PLATFORM_WEB)
+	// the web build has no threads, so bake when the result is first polled
+	streamedLevel.pendingBake = std::async(std::launch::deferred, &LevelStreamer::bake_level, level);
+#else
+	streamedLevel.pendingBake = std::async(std::launch::async, &LevelStreamer::bake_level, level);
+#endif
+
+	// loading is allowed to allocate, steady-state streaming isn't
+	AllocationTracker::arm_budget(ProfilingConstants::AllocationWarmupFrames);
+}
+
+void LevelStreamer::unload_level(StreamedLevel &streamedLevel)
+{
+	DebugUtils::println("Streaming out level {}", streamedLevel.level->name);
+
+	actors->remove_level(streamedLevel.level);
+	LevelColliders::destroy(streamedLevel.bodies, physicsWorld);
+	streamedLevel.bodies.clear();
+
+	if (streamedLevel.texture.id != 0)
+	{
+		UnloadTexture(streamedLevel.texture);
+		streamedLevel.texture = {};
+	}
+
+	// deferred bakes that never ran can just be dropped
+	auto &bake = streamedLevel.pendingBake;
+	if (bake.valid() && bake.wait_for(std::chrono::seconds(0)) != std::future_status::deferred)
+	{
+		retiredBakes.push_back(std::move(bake));
+	}
+}
+
+void LevelStreamer::collect_finished_bakes()
+{
+	for (auto &&[level, streamedLevel] : loadedLevels)
+	{
+		if (streamedLevel.pendingBake.valid() && is_ready(streamedLevel.pendingBake))
+		{
+			Image bakedImage = streamedLevel.pendingBake.get();
+			streamedLevel.texture = LoadTextureFromImage(bakedImage);
+			UnloadImage(bakedImage);
+		}
+	}
+
+	std::erase_if(retiredBakes, [](std::future<Image> &bake)
+				  {
+					  if (!is_ready(bake))
+					  {
+						  return false;
+					  }
+
+					  UnloadImage(bake.get());
+					  return true;
+				  });
+}
+
+Image LevelStreamer::bake_level(const ldtk::Level *level)
+{
+	Image canvas = GenImageColor(level->size.x, level->size.y, BLANK);
+
+	if (level->hasBgImage())
+	{
+		Image background = CookedTexture::load_asset_image(level->getBgImage().path.c_str());
+
+		// tile background image to cover the whole level
+		for (int x = 0; x < canvas.width; x += background.width)
+		{
+			for (int y = 0; y < canvas.height; y += background.height)
+			{
+				ImageDraw(&canvas,
+						  background,
+						  {0, 0, (float)background.width, (float)background.height},
+						  {(float)x, (float)y, (float)background.width, (float)background.height},
+						  WHITE);
+			}
+		}
+
+		UnloadImage(background);
+	}
+
+	std::unordered_map<std::string, Image> tilesets;
+
+	// LDtk lists layers top-most first, we want to draw bottom-most first
+	const auto &allLayers = level->allLayers();
+	for (auto it = allLayers.rbegin(); it != allLayers.rend(); ++it)
+	{
+		if (!it->hasTileset())
+		{
+			continue;
+		}
+
+		const auto &tilesetPath = it->getTileset().path;
+		if (!tilesets.contains(tilesetPath))
+		{
+			tilesets[tilesetPath] = CookedTexture::load_asset_image(tilesetPath);
+		}
+
+		const auto &tileset = tilesets[tilesetPath];
+		auto tileSize = float(it->getTileset().tile_size);
+
+		for (auto &&tile : it->allTiles())
+		{
+			auto sourcePos = tile.getTextureRect();
+			Rectangle sourceRect = {float(sourcePos.x), float(sourcePos.y), tileSize, tileSize};
+			Rectangle targetRect = {float(tile.getPosition().x), float(tile.getPosition().y), tileSize, tileSize};
+
+			if (!tile.flipX && !tile.flipY)
+			{
+				ImageDraw(&canvas, tileset, sourceRect, targetRect, WHITE);
+				continue;
+			}
+
+			// ImageDraw can't mirror, so flipped tiles are copied and flipped first
+			Image flippedTile = ImageFromImage(tileset, sourceRect);
+			if (tile.flipX)
+			{
+				ImageFlipHorizontal(&flippedTile);
+			}
+			if (tile.flipY)
+			{
+				ImageFlipVertical(&flippedTile);
+			}
+
+			ImageDraw(&canvas, flippedTile, {0, 0, tileSize, tileSize}, targetRect, WHITE);
+			UnloadImage(flippedTile);
+		}
+	}
+
+	for (auto &&[path, image] : tilesets)
+	{
+		UnloadImage(image);
+	}
+
+	return canvas;
+}
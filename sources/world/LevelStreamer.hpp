@@ -0,0 +1,75 @@
+#pragma once
+
+#include <future>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/World.hpp>
+
+#include "../entities/Actors/ActorSystem.hpp"
+#include "../physics/CollisionGrid.hpp"
+
+/**
+ * Keeps the LDtk levels around a focus point (usually the player) loaded into a
+ * single persistent physics world, using the world-space position LDtk stores
+ * for each level. Levels that get close are loaded (colliders are created
+ * right away, their texture is baked on a worker thread) and levels that get
+ * far away are unloaded again, so memory stays bounded no matter how big the
+ * world is. The actors of a level come and go with it.
+ */
+class LevelStreamer
+{
+private:
+    struct StreamedLevel
+    {
+        const ldtk::Level *level{};
+        Rectangle rect{};
+        std::vector<b2Body *> bodies;
+        CollisionGrid grid;
+
+        std::future<Image> pendingBake;
+        Texture2D texture{};
+    };
+
+    const ldtk::World *ldtkWorld;
+    b2World *physicsWorld;
+    ActorSystem *actors;
+    Rectangle worldBounds{};
+
+    std::unordered_map<const ldtk::Level *, StreamedLevel> loadedLevels;
+
+    // bakes of levels that were unloaded before their bake finished
+    std::vector<std::future<Image>> retiredBakes;
+
+    void load_level(const ldtk::Level *level);
+    void unload_level(StreamedLevel &streamedLevel);
+    void collect_finished_bakes();
+
+    static Image bake_level(const ldtk::Level *level);
+
+public:
+    // `actors` gets the actors of every loaded level, they must be set to
+    // create their bodies in `physicsWorld`
+    LevelStreamer(const ldtk::World *ldtkWorld, b2World *physicsWorld, ActorSystem *actors);
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer &) = delete;
+    LevelStreamer &operator=(const LevelStreamer &) = delete;
+
+    // Loads and unloads levels around `focus`, which is in world pixels.
+    // Returns whether any level was loaded or unloaded, i.e. whether the
+    // static bodies of the physics world changed.
+    bool update(Vector2 focus);
+    void draw() const;
+
+    // Rectangle in world pixels that covers every level of the world
+    Rectangle get_world_bounds() const;
+    size_t loaded_level_count() const;
+
+    // Collision grid of the loaded level containing `position`, or nullptr
+    const CollisionGrid *get_collision_grid_at(Vector2 position) const;
+
+    static Rectangle get_level_rect(const ldtk::Level *level);
+};
@@ -0,0 +1,214 @@
+#include <memory>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/Level.hpp>
+
+#include <Constants.hpp>
+#include <utils/DebugUtils.hpp>
+#include <utils/StateHash.hpp>
+
+#include "Simulation.hpp"
+#include "../physics/LevelColliders.hpp"
+
+Simulation::Simulation(int playerCount, float actorBudgetMs)
+	: actors(actorBudgetMs)
+{
+	for (int i = 0; i < playerCount; i++)
+	{
+		players.push_back(std::make_unique<Player>());
+
+		// players sharing the level don't push each other around
+		if (playerCount > 1)
+		{
+			players.back()->set_collision_group(-1);
+		}
+
+		playerPointers.push_back(players.back().get());
+	}
+
+	reset_world();
+}
+
+void Simulation::load_level(const ldtk::Level *level)
+{
+	reset_world();
+
+	// get entity positions
+	DebugUtils::println("Entities in level:");
+	for (auto &&entity : level->getLayer("Entities").allEntities())
+	{
+		DebugUtils::println("  - {}", entity.getName());
+		if (entity.getName() == "Player")
+		{
+			spawn_players(&entity);
+		}
+
+		if (entity.getName() == "Portal")
+		{
+			float target_lvl = entity.getField<float>("level_destination").value();
+			DebugUtils::println("Portal goes to level: {}", target_lvl);
+		}
+	}
+
+	// create solid blocks on level
+	LevelColliders::create(level, world.get());
+	collisionGrid = CollisionGrid::from_level(level);
+	actors.load_level(level, world.get(), &collisionGrid);
+	this->level = level;
+}
+
+void Simulation::create_world()
+{
+	// the players' old bodies go away with the old world, they get new ones
+	// when they are spawned again
+	b2Vec2 gravity(0.0f, 60.0f);
+	world = std::make_unique<b2World>(gravity);
+}
+
+void Simulation::rebuild_world()
+{
+	create_world();
+
+	for (auto &&player : players)
+	{
+		player->recreate_body(world.get());
+	}
+
+	LevelColliders::create(level, world.get(), {0, 0}, false);
+	actors.load_level(level, world.get(), &collisionGrid);
+}
+
+void Simulation::reset_world()
+{
+	create_world();
+	collisionGrid = CollisionGrid();
+
+	// the actors' bodies went away with the old world
+	actors.clear();
+	actors.set_world(world.get(), nullptr);
+
+	level = nullptr;
+	tickCount = 0;
+}
+
+void Simulation::spawn_players(const ldtk::Entity *entity, Vector2 levelOffset)
+{
+	for (auto &&player : players)
+	{
+		player->init_for_level(entity, world.get(), levelOffset);
+	}
+}
+
+void Simulation::step(std::span<const PlayerInput> inputs)
+{
+	const int32 velocityIterations = 6;
+	const int32 positionIterations = 2;
+
+	world->Step(GameConstants::TickDuration, velocityIterations, positionIterations);
+
+	for (size_t i = 0; i < players.size(); i++)
+	{
+		players[i]->set_input(i < inputs.size() ? inputs[i] : PlayerInput{});
+		players[i]->update(GameConstants::TickDuration);
+	}
+
+	actors.update(GameConstants::TickDuration, actorFocus.value_or(players[0]->get_position()), playerPointers);
+
+	tickCount++;
+}
+
+void Simulation::step(const PlayerInput &input)
+{
+	step(std::span(&input, 1));
+}
+
+uint64_t Simulation::state_hash() const
+{
+	StateHash hash;
+	hash.add(tickCount);
+
+	// Box2D keeps bodies in creation order, which is the same on every run
+	for (auto body = world->GetBodyList(); body != nullptr; body = body->GetNext())
+	{
+		hash.add(body->GetPosition());
+		hash.add(body->GetAngle());
+		hash.add(body->GetLinearVelocity());
+		hash.add(body->GetAngularVelocity());
+		hash.add(body->IsAwake());
+	}
+
+	for (auto &&player : players)
+	{
+		player->add_to_hash(hash);
+	}
+
+	actors.add_to_hash(hash);
+
+	return hash.get();
+}
+
+void Simulation::save_state(State &state) const
+{
+	state.tickCount = tickCount;
+	state.players.resize(players.size());
+	for (size_t i = 0; i < players.size(); i++)
+	{
+		state.players[i] = players[i]->get_state();
+	}
+	actors.save_state(state.actors);
+}
+
+void Simulation::load_state(const State &state)
+{
+	if (level == nullptr)
+	{
+		TraceLog(LOG_WARNING, "Simulation state can only be loaded after load_level");
+		return;
+	}
+
+	rebuild_world();
+
+	for (size_t i = 0; i < players.size(); i++)
+	{
+		players[i]->set_state(state.players[i]);
+	}
+	actors.load_state(state.actors);
+
+	tickCount = state.tickCount;
+}
+
+void Simulation::set_actor_focus(Vector2 focus)
+{
+	actorFocus = focus;
+}
+
+b2World *Simulation::get_world() const
+{
+	return world.get();
+}
+
+ActorSystem &Simulation::get_actors()
+{
+	return actors;
+}
+
+Player *Simulation::get_player(int index) const
+{
+	return players[index].get();
+}
+
+int Simulation::get_player_count() const
+{
+	return (int)players.size();
+}
+
+const CollisionGrid &Simulation::get_collision_grid() const
+{
+	return collisionGrid;
+}
+
+int Simulation::get_tick_count() const
+{
+	return tickCount;
+}
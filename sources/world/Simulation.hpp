@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <raylib.h>
+#include <box2d/box2d.h>
+#include <LDtkLoader/Level.hpp>
+#include <LDtkLoader/Entity.hpp>
+
+#include "../entities/Actors/ActorSystem.hpp"
+#include "../entities/Player/Player.hpp"
+#include "../physics/CollisionGrid.hpp"
+
+/**
+ * Everything that makes up a running level: the physics world, the players,
+ * the traps and enemies (see ActorSystem) and the level's collision grid. Nothing in here is static and nothing touches
+ * the GPU, so any number of simulations can run side by side, each on its own
+ * thread (see BatchRunner). GameScene owns one and draws it.
+ */
+class Simulation
+{
+private:
+    std::unique_ptr<b2World> world;
+    std::vector<std::unique_ptr<Player>> players;
+
+    // the same players, the way ActorSystem::update takes them
+    std::vector<Player *> playerPointers;
+
+    CollisionGrid collisionGrid;
+    ActorSystem actors;
+
+    // what actors are updated more often around, the first player if unset
+    std::optional<Vector2> actorFocus;
+
+    // level given to load_level, states can only be loaded once there is one
+    const ldtk::Level *level{};
+
+    int tickCount = 0;
+
+    void create_world();
+
+    // Fresh world holding the level and new bodies for the players and
+    // actors, in the order load_level creates them
+    void rebuild_world();
+
+public:
+    // Everything needed to put a simulation back to an earlier tick. The
+    // players and the actors are the only bodies that move, the rest of the
+    // world is the level.
+    struct State
+    {
+        int tickCount = 0;
+        std::vector<Player::State> players;
+        ActorSystem::State actors;
+    };
+
+    // Actors get `actorBudgetMs` of CPU time per tick. Which actors fit a
+    // real budget depends on the machine, so only the game gives them one.
+    explicit Simulation(int playerCount = 1, float actorBudgetMs = ActorConstants::UnlimitedBudgetMs);
+
+    // Replaces the physics world with a fresh one holding the level's colliders
+    // and actors, and spawns the players wherever the level places the player
+    void load_level(const ldtk::Level *level);
+
+    // Replaces the physics world with an empty one, used when someone else
+    // (e.g. LevelStreamer) adds the level geometry and actors
+    void reset_world();
+
+    void spawn_players(const ldtk::Entity *entity, Vector2 levelOffset = {0, 0});
+
+    // Advances the physics world, the players and the actors by
+    // GameConstants::TickDuration, with one input per player
+    void step(std::span<const PlayerInput> inputs);
+    void step(const PlayerInput &input);
+
+    // FNV hash of the state of every body, player and actor. Two simulations
+    // that were given the same level and inputs must have the same hash on
+    // every tick, see `--check-determinism` in main.cpp
+    uint64_t state_hash() const;
+
+    // Only supported after load_level. `state` is reused to avoid allocating.
+    void save_state(State &state) const;
+
+    // Rebuilds the physics world from the level and puts the players and
+    // actors where `state` had them. Box2D's contacts, warm starting impulses
+    // and broadphase pairs start over, so stepping from a loaded state gives
+    // the same result no matter what the world went through before. Callers
+    // that need the same result on every peer (see RollbackSession) load the
+    // state before every tick, not only when rolling back.
+    void load_state(const State &state);
+
+    // Actors update more often close to `focus` (in world pixels), e.g. the
+    // center of the camera
+    void set_actor_focus(Vector2 focus);
+
+    b2World *get_world() const;
+    ActorSystem &get_actors();
+    Player *get_player(int index = 0) const;
+    int get_player_count() const;
+    const CollisionGrid &get_collision_grid() const;
+
+    // Number of steps since the last level load
+    int get_tick_count() const;
+};
@@ -0,0 +1,257 @@
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <Constants.hpp>
+#include <audio/AudioMixer.hpp>
+
+#include "Tests.hpp"
+
+namespace
+{
+	constexpr int SoundFrames = 1000;
+
+	bool near(float a, float b)
+	{
+		return std::abs(a - b) < 1e-5f;
+	}
+
+	// every sample of both channels is `value`
+	SoundData make_sound(float value, int frames = SoundFrames)
+	{
+		return {.samples = std::vector<float>(frames * 2, value)};
+	}
+
+	// fully left by default, so the left channel is exactly the sample times
+	// the volume and the right one is silent
+	AudioMixer::PlayRequest play(const SoundData &sound, int priority = 0, float pan = -1.0f, float volume = 1.0f)
+	{
+		return {
+			.sound = &sound,
+			.priority = priority,
+			.volume = volume,
+			.pan = pan,
+			.requestedAt = AudioMixer::Clock::now(),
+		};
+	}
+
+	// mixes a single frame and returns it
+	std::array<float, 2> mix_frame(AudioMixer &mixer)
+	{
+		std::array<float, 2> frame{};
+		mixer.mix(frame.data(), 1);
+		return frame;
+	}
+
+	// one sound per voice, each with its own small value so the mix tells
+	// which ones are playing
+	std::vector<SoundData> make_voice_sounds()
+	{
+		std::vector<SoundData> sounds;
+		for (int i = 0; i < AudioConstants::VoiceCount; i++)
+		{
+			sounds.push_back(make_sound((i + 1) * 0.001f));
+		}
+		return sounds;
+	}
+
+	float sum_of(const std::vector<SoundData> &sounds)
+	{
+		float sum = 0;
+		for (auto &&sound : sounds)
+		{
+			sum += sound.samples[0];
+		}
+		return sum;
+	}
+
+	void audio_mixer_pans_with_equal_power()
+	{
+		auto sound = make_sound(0.5f);
+
+		AudioMixer left;
+		left.submit(play(sound, 0, -1.0f));
+		auto leftFrame = mix_frame(left);
+		TEST_CHECK(near(leftFrame[0], 0.5f));
+		TEST_CHECK(near(leftFrame[1], 0.0f));
+
+		AudioMixer right;
+		right.submit(play(sound, 0, 1.0f));
+		auto rightFrame = mix_frame(right);
+		TEST_CHECK(near(rightFrame[0], 0.0f));
+		TEST_CHECK(near(rightFrame[1], 0.5f));
+
+		// as loud in the middle as on either side
+		AudioMixer center;
+		center.submit(play(sound, 0, 0.0f));
+		auto centerFrame = mix_frame(center);
+		TEST_CHECK(near(centerFrame[0], centerFrame[1]));
+		TEST_CHECK(near(centerFrame[0] * centerFrame[0] + centerFrame[1] * centerFrame[1], 0.25f));
+
+		// out of range pans are clamped, the volume scales both gains
+		AudioMixer quiet;
+		quiet.submit(play(sound, 0, -3.0f, 0.5f));
+		auto quietFrame = mix_frame(quiet);
+		TEST_CHECK(near(quietFrame[0], 0.25f));
+		TEST_CHECK(near(quietFrame[1], 0.0f));
+	}
+
+	void audio_mixer_steals_lowest_priority_oldest_voice()
+	{
+		auto sounds = make_voice_sounds();
+		auto newSound = make_sound(0.1f);
+
+		// every voice at priority 1 except two older ones at priority 0
+		AudioMixer mixer;
+		for (int i = 0; i < AudioConstants::VoiceCount; i++)
+		{
+			mixer.submit(play(sounds[i], i == 3 || i == 7 ? 0 : 1));
+		}
+		float playing = sum_of(sounds);
+		TEST_CHECK(near(mix_frame(mixer)[0], playing));
+		TEST_CHECK(mixer.get_metrics().activeVoices == AudioConstants::VoiceCount);
+		TEST_CHECK(mixer.get_metrics().steals == 0);
+
+		// the lowest priority goes first, the oldest of those before the newer one
+		mixer.submit(play(newSound, 1));
+		playing += newSound.samples[0] - sounds[3].samples[0];
+		TEST_CHECK(near(mix_frame(mixer)[0], playing));
+
+		mixer.submit(play(newSound, 1));
+		playing += newSound.samples[0] - sounds[7].samples[0];
+		TEST_CHECK(near(mix_frame(mixer)[0], playing));
+
+		// only priority 1 is left, so the oldest of all of them goes
+		mixer.submit(play(newSound, 1));
+		playing += newSound.samples[0] - sounds[0].samples[0];
+		TEST_CHECK(near(mix_frame(mixer)[0], playing));
+
+		auto metrics = mixer.get_metrics();
+		TEST_CHECK(metrics.steals == 3);
+		TEST_CHECK(metrics.rejected == 0);
+		TEST_CHECK(metrics.activeVoices == AudioConstants::VoiceCount);
+		TEST_CHECK(metrics.peakVoices == AudioConstants::VoiceCount);
+	}
+
+	void audio_mixer_rejects_lower_priority_requests()
+	{
+		auto sounds = make_voice_sounds();
+		auto newSound = make_sound(0.1f);
+
+		AudioMixer mixer;
+		for (auto &&sound : sounds)
+		{
+			mixer.submit(play(sound, 2));
+		}
+		float playing = sum_of(sounds);
+		mix_frame(mixer);
+
+		// less important than everything playing, nothing is cut off
+		mixer.submit(play(newSound, 1));
+		TEST_CHECK(near(mix_frame(mixer)[0], playing));
+		TEST_CHECK(mixer.get_metrics().rejected == 1);
+		TEST_CHECK(mixer.get_metrics().steals == 0);
+
+		// as important as the oldest one playing is enough
+		mixer.submit(play(newSound, 2));
+		playing += newSound.samples[0] - sounds[0].samples[0];
+		TEST_CHECK(near(mix_frame(mixer)[0], playing));
+		TEST_CHECK(mixer.get_metrics().rejected == 1);
+		TEST_CHECK(mixer.get_metrics().steals == 1);
+	}
+
+	void audio_mixer_stops_all_voices()
+	{
+		auto sound = make_sound(0.1f);
+
+		AudioMixer mixer;
+		for (int i = 0; i < 3; i++)
+		{
+			mixer.submit(play(sound));
+		}
+		TEST_CHECK(near(mix_frame(mixer)[0], 0.3f));
+		TEST_CHECK(mixer.get_metrics().activeVoices == 3);
+
+		// a request without a sound stops everything, later requests still play
+		mixer.submit({});
+		auto silent = mix_frame(mixer);
+		TEST_CHECK(silent[0] == 0.0f && silent[1] == 0.0f);
+		TEST_CHECK(mixer.get_metrics().activeVoices == 0);
+
+		mixer.submit({});
+		mixer.submit(play(sound));
+		TEST_CHECK(near(mix_frame(mixer)[0], 0.1f));
+		TEST_CHECK(mixer.get_metrics().activeVoices == 1);
+	}
+
+	void audio_mixer_drops_requests_when_queue_is_full()
+	{
+		auto sound = make_sound(0.01f);
+
+		// nothing mixes in between, so nothing leaves the queue
+		AudioMixer mixer;
+		for (int i = 0; i < AudioConstants::RequestQueueSize; i++)
+		{
+			TEST_CHECK(mixer.submit(play(sound)));
+		}
+		TEST_CHECK(!mixer.submit(play(sound)));
+		TEST_CHECK(!mixer.submit(play(sound)));
+		TEST_CHECK(mixer.get_metrics().dropped == 2);
+
+		// every queued request starts, the ones past the voice count steal
+		mix_frame(mixer);
+		auto metrics = mixer.get_metrics();
+		TEST_CHECK(metrics.activeVoices == AudioConstants::VoiceCount);
+		TEST_CHECK(metrics.steals == AudioConstants::RequestQueueSize - AudioConstants::VoiceCount);
+		TEST_CHECK(metrics.dropped == 2);
+
+		// and the queue takes requests again
+		TEST_CHECK(mixer.submit(play(sound)));
+	}
+
+	void audio_mixer_voices_end_with_their_sound()
+	{
+		auto sound = make_sound(0.25f, 10);
+
+		AudioMixer mixer;
+		mixer.submit(play(sound));
+
+		std::array<float, 8> output{};
+		mixer.mix(output.data(), 4);
+		mixer.mix(output.data(), 4);
+		TEST_CHECK(mixer.get_metrics().activeVoices == 1);
+
+		// the last two frames of the sound, then silence
+		mixer.mix(output.data(), 4);
+		TEST_CHECK(near(output[2], 0.25f));
+		TEST_CHECK(output[4] == 0.0f && output[6] == 0.0f);
+
+		mixer.mix(output.data(), 4);
+		TEST_CHECK(mixer.get_metrics().activeVoices == 0);
+		TEST_CHECK(mixer.get_metrics().peakVoices == 1);
+		for (float sample : output)
+		{
+			TEST_CHECK(sample == 0.0f);
+		}
+	}
+
+	void audio_mixer_clamps_loud_mixes()
+	{
+		auto sound = make_sound(0.5f);
+
+		AudioMixer mixer;
+		for (int i = 0; i < 4; i++)
+		{
+			mixer.submit(play(sound));
+		}
+		TEST_CHECK(mix_frame(mixer)[0] == 1.0f);
+	}
+
+	Tests::Registrar pan("audio_mixer_pans_with_equal_power", &audio_mixer_pans_with_equal_power);
+	Tests::Registrar steal("audio_mixer_steals_lowest_priority_oldest_voice", &audio_mixer_steals_lowest_priority_oldest_voice);
+	Tests::Registrar reject("audio_mixer_rejects_lower_priority_requests", &audio_mixer_rejects_lower_priority_requests);
+	Tests::Registrar stop("audio_mixer_stops_all_voices", &audio_mixer_stops_all_voices);
+	Tests::Registrar queueFull("audio_mixer_drops_requests_when_queue_is_full", &audio_mixer_drops_requests_when_queue_is_full);
+	Tests::Registrar voiceEnd("audio_mixer_voices_end_with_their_sound", &audio_mixer_voices_end_with_their_sound);
+	Tests::Registrar clamp("audio_mixer_clamps_loud_mixes", &audio_mixer_clamps_loud_mixes);
+}
@@ -0,0 +1,191 @@
+#include <cmath>
+#include <list>
+
+#include <box2d/box2d.h>
+#include <LDtkLoader/Project.hpp>
+
+#include <Constants.hpp>
+#include <entities/Actors/ActorDefinition.hpp>
+#include <entities/Actors/ActorSystem.hpp>
+#include <physics/CollisionGrid.hpp>
+#include <physics/LevelColliders.hpp>
+#include <physics/PhysicsTypes.hpp>
+#include <utils/AssetRegistry.hpp>
+#include <world/Simulation.hpp>
+
+#include "Tests.hpp"
+
+namespace
+{
+	bool near(float a, float b)
+	{
+		return std::abs(a - b) < 1e-3f;
+	}
+
+	// center of an entity, in world pixels
+	Vector2 get_center(const ldtk::Entity &entity, Vector2 offset = {0, 0})
+	{
+		return {
+			offset.x + entity.getPosition().x + entity.getSize().x / 2.0f,
+			offset.y + entity.getPosition().y + entity.getSize().y / 2.0f,
+		};
+	}
+
+	void level_colliders_match_physics_entities()
+	{
+		ldtk::Project project;
+		project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+		const Vector2 offset = {100, 50};
+		for (auto &&level : project.getWorld().allLevels())
+		{
+			const auto &entities = level.getLayer("PhysicsEntities").allEntities();
+			TEST_CHECK(!entities.empty());
+
+			b2World world({0.0f, 60.0f});
+			auto bodies = LevelColliders::create(&level, &world, offset, false);
+			TEST_CHECK(bodies.size() == entities.size());
+			TEST_CHECK(world.GetBodyCount() == (int32)bodies.size());
+
+			for (size_t i = 0; i < bodies.size() && i < entities.size(); i++)
+			{
+				// one static box per entity, centered on it and offset with the level
+				auto center = get_center(entities[i], offset);
+				auto body = bodies[i];
+				TEST_CHECK(body->GetType() == b2_staticBody);
+				TEST_CHECK(near(body->GetPosition().x * GameConstants::PhysicsWorldScale, center.x));
+				TEST_CHECK(near(body->GetPosition().y * GameConstants::PhysicsWorldScale, center.y));
+				TEST_CHECK((const char *)body->GetUserData().pointer == PhysicsTypes::SolidBlock.data());
+
+				// SetAsBox puts the top right corner at the half extents
+				auto box = static_cast<const b2PolygonShape *>(body->GetFixtureList()->GetShape());
+				TEST_CHECK(box->m_count == 4);
+				TEST_CHECK(near(box->m_vertices[2].x * 2 * GameConstants::PhysicsWorldScale, (float)entities[i].getSize().x));
+				TEST_CHECK(near(box->m_vertices[2].y * 2 * GameConstants::PhysicsWorldScale, (float)entities[i].getSize().y));
+			}
+
+			LevelColliders::destroy(bodies, &world);
+			TEST_CHECK(world.GetBodyCount() == 0);
+		}
+	}
+
+	void collision_grid_matches_physics_entities()
+	{
+		ldtk::Project project;
+		project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+		for (auto &&level : project.getWorld().allLevels())
+		{
+			auto grid = CollisionGrid::from_level(&level);
+			TEST_CHECK(grid.get_width() > 0 && grid.get_height() > 0);
+
+			for (auto &&entity : level.getLayer("PhysicsEntities").allEntities())
+			{
+				TEST_CHECK(grid.is_solid_at(get_center(entity)));
+			}
+
+			// the player starts in the air
+			for (auto &&entity : level.getLayer("Entities").allEntities())
+			{
+				if (entity.getName() == "Player")
+				{
+					TEST_CHECK(!grid.is_solid_at(get_center(entity)));
+				}
+			}
+
+			// nothing outside of the level is solid
+			TEST_CHECK(!grid.is_solid_at({-1.0f, -1.0f}));
+		}
+	}
+
+	void simulation_loads_every_level()
+	{
+		ldtk::Project project;
+		project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+		for (auto &&level : project.getWorld().allLevels())
+		{
+			Simulation simulation;
+			simulation.load_level(&level);
+			TEST_CHECK(simulation.get_tick_count() == 0);
+
+			int expectedBodies = (int)level.getLayer("PhysicsEntities").allEntities().size();
+			size_t expectedActors = 0;
+			for (auto &&entity : level.getLayer("Entities").allEntities())
+			{
+				if (entity.getName() == "Player")
+				{
+					// the player's body is placed at the entity's position
+					auto position = simulation.get_player()->get_position();
+					TEST_CHECK(near(position.x, (float)entity.getPosition().x));
+					TEST_CHECK(near(position.y, (float)entity.getPosition().y));
+					expectedBodies++;
+				}
+
+				if (auto definition = ActorDefinition::from_entity(entity, {0, 0}))
+				{
+					expectedActors++;
+					expectedBodies += definition->solid ? 1 : 0;
+				}
+			}
+
+			TEST_CHECK(simulation.get_world()->GetBodyCount() == expectedBodies);
+			TEST_CHECK(simulation.get_actors().get_actor_count() == expectedActors);
+			TEST_CHECK(simulation.get_collision_grid().get_width() > 0);
+		}
+	}
+
+	// what LevelStreamer does, every level at its place in the world and in one physics world
+	void streamed_levels_add_and_remove_their_actors()
+	{
+		ldtk::Project project;
+		project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+		b2World world(b2Vec2(0.0f, 60.0f));
+		ActorSystem actors;
+		actors.set_world(&world, nullptr);
+
+		// grids have to stay where they are while their actors use them
+		std::list<CollisionGrid> grids;
+		size_t expectedActors = 0;
+		int expectedBodies = 0;
+
+		for (auto &&level : project.getWorld().allLevels())
+		{
+			Vector2 offset = {(float)level.position.x, (float)level.position.y};
+			grids.push_back(CollisionGrid::from_level(&level, offset));
+			actors.add_level(&level, &grids.back(), offset);
+
+			for (auto &&entity : level.getLayer("Entities").allEntities())
+			{
+				if (auto definition = ActorDefinition::from_entity(entity, offset))
+				{
+					expectedActors++;
+					expectedBodies += definition->solid ? 1 : 0;
+				}
+			}
+
+			TEST_CHECK(actors.get_actor_count() == expectedActors);
+			TEST_CHECK(world.GetBodyCount() == expectedBodies);
+		}
+
+		// a few ticks so patrolling actors walk on their own level's grid
+		for (int i = 0; i < 60; i++)
+		{
+			actors.update(GameConstants::TickDuration, {0, 0}, {});
+		}
+
+		for (auto &&level : project.getWorld().allLevels())
+		{
+			actors.remove_level(&level);
+		}
+
+		TEST_CHECK(actors.get_actor_count() == 0);
+		TEST_CHECK(world.GetBodyCount() == 0);
+	}
+
+	Tests::Registrar colliders("level_colliders_match_physics_entities", &level_colliders_match_physics_entities);
+	Tests::Registrar grid("collision_grid_matches_physics_entities", &collision_grid_matches_physics_entities);
+	Tests::Registrar levels("simulation_loads_every_level", &simulation_loads_every_level);
+	Tests::Registrar streamedLevels("streamed_levels_add_and_remove_their_actors", &streamed_levels_add_and_remove_their_actors);
+}
@@ -0,0 +1,134 @@
+#include <cmath>
+
+#include <LDtkLoader/Project.hpp>
+
+#include <utils/AssetRegistry.hpp>
+#include <world/Simulation.hpp>
+
+#include "Tests.hpp"
+
+namespace
+{
+	// the player spawns above a ledge in the first level and falls onto it
+	constexpr int SettleTicks = 120;
+
+	// what Player::check_if_move and check_if_jump set the velocity to
+	constexpr float WalkSpeed = 15.0f;
+	constexpr float JumpSpeed = 25.0f;
+
+	void settle(Simulation &simulation)
+	{
+		for (int tick = 0; tick < SettleTicks; tick++)
+		{
+			simulation.step(PlayerInput{});
+		}
+	}
+
+	void player_rests_on_ground()
+	{
+		ldtk::Project project;
+		project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+		Simulation simulation;
+		simulation.load_level(&project.getWorld().getLevel(0));
+
+		auto spawn = simulation.get_player()->get_state();
+		settle(simulation);
+		auto state = simulation.get_player()->get_state();
+
+		TEST_CHECK(state.isTouchingFloor);
+		TEST_CHECK(state.position.y > spawn.position.y);
+		TEST_CHECK(std::abs(state.velocity.x) < 1e-3f);
+		TEST_CHECK(std::abs(state.velocity.y) < 1e-3f);
+		TEST_CHECK(state.respawnCount == 0);
+
+		// resting stays resting
+		simulation.step(PlayerInput{});
+		TEST_CHECK(std::abs(simulation.get_player()->get_state().position.y - state.position.y) < 1e-3f);
+	}
+
+	void player_walks_left_and_right()
+	{
+		ldtk::Project project;
+		project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+		Simulation simulation;
+		simulation.load_level(&project.getWorld().getLevel(0));
+		settle(simulation);
+		auto start = simulation.get_player()->get_state();
+
+		// the walk speed is set after the tick's physics step, so it's exact
+		simulation.step(PlayerInput{.right = true});
+		auto right = simulation.get_player()->get_state();
+		TEST_CHECK(right.velocity.x == WalkSpeed);
+		TEST_CHECK(right.lookingRight);
+
+		for (int tick = 0; tick < 5; tick++)
+		{
+			simulation.step(PlayerInput{.right = true});
+		}
+		auto walkedRight = simulation.get_player()->get_state();
+		TEST_CHECK(walkedRight.position.x > start.position.x);
+		TEST_CHECK(walkedRight.isTouchingFloor);
+
+		simulation.step(PlayerInput{.left = true});
+		auto left = simulation.get_player()->get_state();
+		TEST_CHECK(left.velocity.x == -WalkSpeed);
+		TEST_CHECK(!left.lookingRight);
+
+		for (int tick = 0; tick < 5; tick++)
+		{
+			simulation.step(PlayerInput{.left = true});
+		}
+		TEST_CHECK(simulation.get_player()->get_state().position.x < walkedRight.position.x);
+
+		// letting go slows the player down without turning them around
+		simulation.step(PlayerInput{});
+		auto released = simulation.get_player()->get_state();
+		TEST_CHECK(released.velocity.x < 0.0f);
+		TEST_CHECK(released.velocity.x > -WalkSpeed);
+		TEST_CHECK(!released.lookingRight);
+	}
+
+	void player_jump_velocity()
+	{
+		ldtk::Project project;
+		project.loadFromFile(AssetRegistry::get_path(AssetId::WORLD));
+
+		Simulation simulation;
+		simulation.load_level(&project.getWorld().getLevel(0));
+		settle(simulation);
+
+		// the jump sets the velocity after the tick's physics step, so it's exact
+		simulation.step(PlayerInput{.jump = true});
+		auto jumpState = simulation.get_player()->get_state();
+		TEST_CHECK(simulation.get_player()->has_jumped());
+		TEST_CHECK(jumpState.velocity.y == -JumpSpeed);
+
+		// then gravity slows the player down every tick, and it's in the air
+		simulation.step(PlayerInput{});
+		auto risingState = simulation.get_player()->get_state();
+		TEST_CHECK(risingState.velocity.y > jumpState.velocity.y);
+		TEST_CHECK(risingState.velocity.y < 0.0f);
+		TEST_CHECK(risingState.position.y < jumpState.position.y);
+		TEST_CHECK(!risingState.isTouchingFloor);
+
+		// pressing jump in the air gives no second impulse, gravity keeps
+		// slowing the player down by the same amount as on the tick before
+		simulation.step(PlayerInput{.jump = true});
+		auto airJumpState = simulation.get_player()->get_state();
+		float gravityPerTick = risingState.velocity.y - jumpState.velocity.y;
+		TEST_CHECK(!simulation.get_player()->has_jumped());
+		TEST_CHECK(std::abs(airJumpState.velocity.y - (risingState.velocity.y + gravityPerTick)) < 1e-3f);
+
+		// and the player comes back down onto the ledge
+		settle(simulation);
+		auto landedState = simulation.get_player()->get_state();
+		TEST_CHECK(landedState.isTouchingFloor);
+		TEST_CHECK(std::abs(landedState.position.y - jumpState.position.y) < 0.01f);
+	}
+
+	Tests::Registrar ground("player_rests_on_ground", &player_rests_on_ground);
+	Tests::Registrar walk("player_walks_left_and_right", &player_walks_left_and_right);
+	Tests::Registrar jump("player_jump_velocity", &player_jump_velocity);
+}
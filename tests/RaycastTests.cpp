@@ -0,0 +1,89 @@
+#include <cmath>
+#include <memory>
+
+#include <box2d/box2d.h>
+
+#include <physics/PhysicsTypes.hpp>
+#include <physics/RaycastUtils.hpp>
+
+#include "Tests.hpp"
+
+namespace
+{
+	bool near(float a, float b)
+	{
+		return std::abs(a - b) < 1e-4f;
+	}
+
+	// a thin solid block at y 1.5-2.5 in front of a bigger untagged one at y
+	// 5-7, the far one created first so the callback sees it before the near one
+	std::unique_ptr<b2World> make_world()
+	{
+		auto world = std::make_unique<b2World>(b2Vec2(0.0f, 10.0f));
+
+		auto add_box = [&](b2Vec2 center, float halfWidth, float halfHeight, const char *userData)
+		{
+			b2BodyDef bodyDef;
+			bodyDef.position = center;
+			bodyDef.userData.pointer = (uintptr_t)userData;
+			auto body = world->CreateBody(&bodyDef);
+
+			b2PolygonShape box;
+			box.SetAsBox(halfWidth, halfHeight);
+			body->CreateFixture(&box, 0.0f);
+			return body;
+		};
+
+		add_box({0.0f, 6.0f}, 1.0f, 1.0f, nullptr);
+		add_box({0.0f, 2.0f}, 1.0f, 0.5f, PhysicsTypes::SolidBlock.data());
+
+		return world;
+	}
+
+	void raycast_hits_nearest_fixture()
+	{
+		auto world = make_world();
+
+		RaysCastGetNearestCallback callback;
+		world->RayCast(&callback, {0.0f, 0.0f}, {0.0f, 10.0f});
+
+		TEST_CHECK(callback.m_fixture != nullptr);
+		if (callback.m_fixture == nullptr)
+		{
+			return;
+		}
+
+		TEST_CHECK(callback.m_fixture->GetBody()->GetPosition().y == 2.0f);
+		TEST_CHECK(near(callback.m_point.x, 0.0f));
+		TEST_CHECK(near(callback.m_point.y, 1.5f));
+		TEST_CHECK(near(callback.m_normal.x, 0.0f));
+		TEST_CHECK(near(callback.m_normal.y, -1.0f));
+		TEST_CHECK(near(callback.m_fraction, 0.15f));
+
+		TEST_CHECK(RaycastGetFirstFixtureFromSourceToTarget(world.get(), {0.0f, 0.0f}, {0.0f, 10.0f}) == callback.m_fixture);
+		TEST_CHECK(RaycastCheckCollisionWithUserData(world.get(), {0.0f, 0.0f}, {0.0f, 10.0f}, PhysicsTypes::SolidBlock));
+		TEST_CHECK(!RaycastCheckCollisionWithUserData(world.get(), {0.0f, 0.0f}, {0.0f, 10.0f}, "SOMETHING_ELSE"));
+
+		// from below the near block only the far one is in the way, and it has no user data
+		RaysCastGetNearestCallback fromBelow;
+		world->RayCast(&fromBelow, {0.0f, 10.0f}, {0.0f, 3.0f});
+		TEST_CHECK(fromBelow.m_fixture != nullptr && fromBelow.m_fixture->GetBody()->GetPosition().y == 6.0f);
+		TEST_CHECK(near(fromBelow.m_normal.y, 1.0f));
+		TEST_CHECK(!RaycastCheckCollisionWithUserData(world.get(), {0.0f, 10.0f}, {0.0f, 3.0f}, PhysicsTypes::SolidBlock));
+	}
+
+	void raycast_misses()
+	{
+		auto world = make_world();
+
+		// beside both blocks
+		TEST_CHECK(RaycastGetFirstFixtureFromSourceToTarget(world.get(), {3.0f, 0.0f}, {3.0f, 10.0f}) == nullptr);
+
+		// stops short of the near block
+		TEST_CHECK(RaycastGetFirstFixtureFromSourceToTarget(world.get(), {0.0f, 0.0f}, {0.0f, 1.4f}) == nullptr);
+		TEST_CHECK(!RaycastCheckCollisionWithUserData(world.get(), {0.0f, 0.0f}, {0.0f, 1.4f}, PhysicsTypes::SolidBlock));
+	}
+
+	Tests::Registrar hit("raycast_hits_nearest_fixture", &raycast_hits_nearest_fixture);
+	Tests::Registrar miss("raycast_misses", &raycast_misses);
+}
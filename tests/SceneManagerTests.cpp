@@ -0,0 +1,55 @@
+#include <raylib.h>
+
+#include <Constants.hpp>
+#include <scenes/SceneManager.hpp>
+
+#include "Tests.hpp"
+
+namespace
+{
+	// scenes load textures, so they need a (hidden) window like `--headless` runs
+	void tick_frames(int frames)
+	{
+		for (int i = 0; i < frames; i++)
+		{
+			BeginDrawing();
+			SceneManager::tick(GameConstants::TickDuration);
+			EndDrawing();
+		}
+	}
+
+	void scene_manager_title_game_title()
+	{
+		SetConfigFlags(FLAG_WINDOW_HIDDEN);
+		InitWindow(AppConstants::ScreenWidth, AppConstants::ScreenHeight, AppConstants::WindowTitle.data());
+
+		SceneManager::initialize();
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::UNSET);
+
+		SceneManager::set_current_screen(Scenes::TITLE);
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::TITLE);
+		tick_frames(2);
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::TITLE);
+
+		SceneManager::set_current_screen(Scenes::GAME);
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::GAME);
+		tick_frames(10);
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::GAME);
+
+		// NONE means staying in the current scene
+		SceneManager::set_current_screen(Scenes::NONE);
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::GAME);
+
+		SceneManager::set_current_screen(Scenes::TITLE);
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::TITLE);
+		tick_frames(2);
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::TITLE);
+
+		SceneManager::cleanup();
+		TEST_CHECK(SceneManager::get_current_screen() == Scenes::UNSET);
+
+		CloseWindow();
+	}
+
+	Tests::Registrar titleGameTitle("scene_manager_title_game_title", &scene_manager_title_game_title);
+}
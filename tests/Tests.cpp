@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Tests.hpp"
+
+namespace
+{
+	struct Test
+	{
+		const char *name;
+		Tests::Function function;
+	};
+
+	// function-local so it's initialized before the first static Registrar uses it
+	std::vector<Test> &registry()
+	{
+		static std::vector<Test> tests;
+		return tests;
+	}
+
+	int failedChecks = 0;
+}
+
+namespace Tests
+{
+	Registrar::Registrar(const char *name, Function function)
+	{
+		registry().push_back({name, function});
+	}
+
+	void list()
+	{
+		for (auto &&test : registry())
+		{
+			std::printf("%s\n", test.name);
+		}
+	}
+
+	void fail(const char *file, int line, const char *expression)
+	{
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+		failedChecks++;
+	}
+
+	int run(std::string_view name)
+	{
+		int testsRun = 0;
+		int testsFailed = 0;
+		for (auto &&test : registry())
+		{
+			if (!name.empty() && name != test.name)
+			{
+				continue;
+			}
+
+			int failedBefore = failedChecks;
+			test.function();
+			testsRun++;
+
+			bool passed = failedChecks == failedBefore;
+			std::printf("%-40s %s\n", test.name, passed ? "passed" : "FAILED");
+			if (!passed)
+			{
+				testsFailed++;
+			}
+		}
+
+		if (testsRun == 0)
+		{
+			std::fprintf(stderr, "No test is called '%.*s'\n", (int)name.size(), name.data());
+			return EXIT_FAILURE;
+		}
+
+		return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string_view>
+
+/**
+ * Tiny test harness for the `tests` executable, the same idea as the
+ * benchmarks': tests register themselves from their own translation unit with
+ * a static `Tests::Registrar`. CTest asks `tests --list` for their names and
+ * runs each one in its own process (see cmake/AddTests.cmake), so a new test
+ * needs no CMake change.
+ *
+ * A failed TEST_CHECK is reported and the test keeps going, so one run shows
+ * every check that failed.
+ */
+namespace Tests
+{
+    using Function = void (*)();
+
+    struct Registrar
+    {
+        Registrar(const char *name, Function function);
+    };
+
+    // Prints the name of every test, one per line
+    void list();
+
+    // Called by TEST_CHECK
+    void fail(const char *file, int line, const char *expression);
+
+    // Runs the test called `name`, or every test if it's empty. Returns the
+    // process exit code.
+    int run(std::string_view name);
+}
+
+#define TEST_CHECK(condition)                             \
+    do                                                    \
+    {                                                     \
+        if (!(condition))                                 \
+        {                                                 \
+            Tests::fail(__FILE__, __LINE__, #condition); \
+        }                                                 \
+    } while (false)
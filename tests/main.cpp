@@ -0,0 +1,18 @@
+#include <cstdlib>
+#include <string_view>
+
+#include "Tests.hpp"
+
+// `tests [name]` runs a single test, or all of them without a name.
+// `tests --list` prints the names.
+int main(int argc, char **argv)
+{
+	auto name = argc > 1 ? std::string_view(argv[1]) : std::string_view();
+	if (name == "--list")
+	{
+		Tests::list();
+		return EXIT_SUCCESS;
+	}
+
+	return Tests::run(name);
+}
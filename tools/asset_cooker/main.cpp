@@ -0,0 +1,73 @@
+// Converts PNG (or any image raylib can decode) assets into the pre-decoded
+// cooked format the game loads from `assets/cooked/`. See utils/CookedTexture.hpp.
+//
+// usage: asset-cooker [--compress] <assets directory> <asset> [<asset>...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include <raylib.h>
+
+#include <utils/CookedTexture.hpp>
+
+int main(int argc, char **argv)
+{
+	SetTraceLogLevel(LOG_WARNING);
+
+	bool compress = false;
+	int argIndex = 1;
+	if (argIndex < argc && std::string_view(argv[argIndex]) == "--compress")
+	{
+		compress = true;
+		argIndex++;
+	}
+
+	if (argc - argIndex < 2)
+	{
+		std::fprintf(stderr, "usage: %s [--compress] <assets directory> <asset> [<asset>...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::string assetsDirectory = argv[argIndex++];
+	if (assetsDirectory.back() != '/')
+	{
+		assetsDirectory += '/';
+	}
+
+	int failed = 0;
+	for (; argIndex < argc; argIndex++)
+	{
+		std::string asset = argv[argIndex];
+		std::string sourcePath = assetsDirectory + asset;
+		std::string cookedPath = assetsDirectory + CookedTexture::get_cooked_name(asset);
+
+		Image image = LoadImage(sourcePath.c_str());
+		if (image.data == nullptr)
+		{
+			std::fprintf(stderr, "Could not load %s\n", sourcePath.c_str());
+			failed++;
+			continue;
+		}
+
+		// the game uploads everything as RGBA8, so do the conversion now instead of at load time
+		ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+		ImageMipmaps(&image);
+
+		MakeDirectory(GetDirectoryPath(cookedPath.c_str()));
+		if (!CookedTexture::save(cookedPath, image, compress))
+		{
+			std::fprintf(stderr, "Could not write %s\n", cookedPath.c_str());
+			failed++;
+		}
+		else
+		{
+			std::printf("Cooked %s (%dx%d, %d mips)\n", asset.c_str(), image.width, image.height, image.mipmaps);
+		}
+
+		UnloadImage(image);
+	}
+
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}